@@ -0,0 +1,44 @@
+# encoding: utf-8
+
+# Example for UI::SetAsyncMode(): Fast progress updates
+module Yast
+  class AsyncModeClient < Client
+    def main
+      Yast.import "UI"
+      @max_progress = 20000
+
+      UI.OpenDialog(
+        VBox(
+          ProgressBar(Id(:pr), "Working...", @max_progress, 0),
+          Label(Id(:status), Opt(:hstretch), ""),
+          Right(PushButton(Id(:close), "&Close"))
+        )
+      )
+
+      # The ChangeWidget() calls in this loop are queued and executed in
+      # batches instead of waiting for the UI each time
+      UI.SetAsyncMode(true)
+
+      (1..@max_progress).each do |progress|
+        UI.ChangeWidget(Id(:pr), :Value, progress)
+        UI.ChangeWidget(Id(:status), :Value, "Item #{progress}")
+
+        if progress % 5000 == 0
+          # Queued calls are only executed with other UI calls:
+          # Show the latest state before doing something that takes long
+          UI.FlushAsyncCalls
+          sleep(1)
+        end
+      end
+
+      UI.SetAsyncMode(false)
+
+      UI.UserInput
+      UI.CloseDialog
+
+      nil
+    end
+  end
+end
+
+Yast::AsyncModeClient.new.main
@@ -0,0 +1,46 @@
+# encoding: utf-8
+
+# Example for UI::BeginBatch() / UI::EndBatch(): Update many widgets at once
+module Yast
+  class Batch1Client < Client
+    def main
+      Yast.import "UI"
+
+      @fields = (1..10).map { |i| "field#{i}".to_sym }
+
+      UI.OpenDialog(
+        VBox(
+          *@fields.map { |field| InputField(Id(field), Opt(:hstretch), field.to_s) },
+          HBox(
+            PushButton(Id(:fill), "&Fill"),
+            PushButton(Id(:clear), "&Clear"),
+            PushButton(Id(:close), "&Close")
+          )
+        )
+      )
+
+      loop do
+        @button = UI.UserInput
+
+        case @button
+        when :fill, :clear
+          UI.BeginBatch
+          @fields.each_with_index do |field, i|
+            UI.ChangeWidget(Id(field), :Value, @button == :fill ? "Value #{i + 1}" : "")
+          end
+          UI.ChangeWidget(Id(:clear), :Enabled, @button == :fill)
+          @results = UI.EndBatch
+          Builtins.y2milestone("Batch results: %1", @results)
+        when :close, :cancel
+          break
+        end
+      end
+
+      UI.CloseDialog
+
+      nil
+    end
+  end
+end
+
+Yast::Batch1Client.new.main
@@ -0,0 +1,50 @@
+# encoding: utf-8
+
+# Example for UI::ChangeWidgets(): Update several widgets with one call
+module Yast
+  class ChangeWidgets1Client < Client
+    def main
+      Yast.import "UI"
+      @max_progress = 7
+      @progress = 0
+
+      UI.OpenDialog(
+        VBox(
+          ProgressBar(Id(:pr), "Sample progress bar", @max_progress, @progress),
+          Label(Id(:status), "Not started yet"),
+          PushButton(Id(:next), "&Next"),
+          Right(PushButton(Id(:close), "&Close"))
+        )
+      )
+
+
+      while Ops.less_than(@progress, @max_progress)
+        @button = Convert.to_symbol(UI.UserInput)
+
+        if @button == :next
+          @progress = Ops.add(@progress, 1)
+          UI.ChangeWidgets(
+            [
+              [Id(:pr), :Value, @progress],
+              [
+                Id(:pr),
+                :Label,
+                Builtins.sformat("Progress %1 of %2", @progress, @max_progress)
+              ],
+              [Id(:status), :Value, Builtins.sformat("Step %1", @progress)],
+              [Id(:next), :Enabled, Ops.less_than(@progress, @max_progress)]
+            ]
+          )
+        elsif @button == :close
+          break
+        end
+      end
+
+      UI.CloseDialog
+
+      nil
+    end
+  end
+end
+
+Yast::ChangeWidgets1Client.new.main
@@ -0,0 +1,34 @@
+# encoding: utf-8
+
+# Example for UI::QueryWidgets(): Get several widget values with one call
+module Yast
+  class QueryWidgets1Client < Client
+    def main
+      Yast.import "UI"
+
+      UI.OpenDialog(
+        VBox(
+          InputField(Id(:name), "&Name"),
+          InputField(Id(:city), "&City"),
+          CheckBox(Id(:member), "&Member", true),
+          PushButton(Id(:ok), "&OK")
+        )
+      )
+
+      UI.UserInput
+
+      @values = UI.QueryWidgets(
+        [[Id(:name), :Value], [Id(:city), :Value], [Id(:member), :Value]]
+      )
+
+      UI.CloseDialog
+
+      Builtins.y2milestone("Values: %1", @values)
+      Builtins.y2milestone("Name: %1", Ops.get(@values, [Id(:name), :Value]))
+
+      nil
+    end
+  end
+end
+
+Yast::QueryWidgets1Client.new.main
@@ -0,0 +1,57 @@
+# encoding: utf-8
+
+# Example for the `Cells property: Change many table cells with one call
+module Yast
+  class TableCellsClient < Client
+    def main
+      Yast.import "UI"
+
+      @prices = [12, 8, 6, 8]
+
+      UI.OpenDialog(
+        VBox(
+          Heading("Today's menu"),
+          MinSize(
+            30,
+            10,
+            Table(
+              Id(:table),
+              Header("Name", Right("Price")),
+              [
+                Item(Id(0), "Steak Sandwich", "12"),
+                Item(Id(1), "Salami Baguette", "8"),
+                Item(Id(2), "Chili", "6"),
+                Item(Id(3), "Spaghetti", "8")
+              ]
+            )
+          ),
+          HBox(
+            PushButton(Id(:raise), "&Raise All Prices"),
+            PushButton(Id(:lower), "&Lower All Prices")
+          ),
+          Right(PushButton(Id(:close), "&Close"))
+        )
+      )
+
+      loop do
+        @button = Convert.to_symbol(UI.UserInput)
+
+        case @button
+        when :raise, :lower
+          @delta = @button == :raise ? 1 : -1
+          @prices.map! { |price| [price + @delta, 0].max }
+          @cells = @prices.each_with_index.map { |price, id| [id, 1, price.to_s] }
+          UI.ChangeWidget(Id(:table), :Cells, @cells)
+        when :close, :cancel
+          break
+        end
+      end
+
+      UI.CloseDialog
+
+      nil
+    end
+  end
+end
+
+Yast::TableCellsClient.new.main
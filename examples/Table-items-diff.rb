@@ -0,0 +1,73 @@
+# encoding: utf-8
+
+# Example for the `ItemsDiff property: Change only some items of a table
+module Yast
+  class TableItemsDiffClient < Client
+    def main
+      Yast.import "UI"
+
+      @next_id = 4
+
+      UI.OpenDialog(
+        VBox(
+          Heading("Today's menu"),
+          MinSize(
+            30,
+            10,
+            Table(
+              Id(:table),
+              Header("Name", Right("Price")),
+              [
+                Item(Id(0), "Steak Sandwich", "12"),
+                Item(Id(1), "Salami Baguette", "8"),
+                Item(Id(2), "Chili", "6"),
+                Item(Id(3), "Spaghetti", "8")
+              ]
+            )
+          ),
+          HBox(
+            PushButton(Id(:add), "&Add"),
+            PushButton(Id(:raise), "&Raise Price"),
+            PushButton(Id(:remove), "Re&move")
+          ),
+          Right(PushButton(Id(:close), "&Close"))
+        )
+      )
+
+      loop do
+        @button = Convert.to_symbol(UI.UserInput)
+        @current = UI.QueryWidget(Id(:table), :CurrentItem)
+
+        case @button
+        when :add
+          UI.ChangeWidget(
+            Id(:table),
+            :ItemsDiff,
+            { "add" => [Item(Id(@next_id), "Daily Special ##{@next_id}", "10")] }
+          )
+          @next_id += 1
+        when :raise
+          next if @current.nil?
+          @name = UI.QueryWidget(Id(:table), Cell(@current, 0))
+          @price = UI.QueryWidget(Id(:table), Cell(@current, 1)).to_i + 1
+          UI.ChangeWidget(
+            Id(:table),
+            :ItemsDiff,
+            { "update" => [Item(Id(@current), @name, @price.to_s)] }
+          )
+        when :remove
+          next if @current.nil?
+          UI.ChangeWidget(Id(:table), :ItemsDiff, { "remove" => [@current] })
+        when :close, :cancel
+          break
+        end
+      end
+
+      UI.CloseDialog
+
+      nil
+    end
+  end
+end
+
+Yast::TableItemsDiffClient.new.main
@@ -0,0 +1,44 @@
+# encoding: utf-8
+
+# Example for a Table with Opt(:lazyItems): Very many items
+module Yast
+  class TableLazyItemsClient < Client
+    def main
+      Yast.import "UI"
+
+      @items = (0...100_000).map do |i|
+        Item(Id(i), "Line #{i}", (i * 7 % 1000).to_s)
+      end
+
+      UI.OpenDialog(
+        VBox(
+          Heading("Lazy Table"),
+          MinSize(
+            40,
+            15,
+            Table(
+              Id(:table),
+              Opt(:lazyItems, :notify),
+              Header("Text", Right("Value")),
+              @items
+            )
+          ),
+          Label(Id(:count), ""),
+          Right(PushButton(Id(:close), "&Close"))
+        )
+      )
+
+      # Querying any property waits until all items are in the table
+      @count = UI.QueryWidget(Id(:table), :Items).size
+      UI.ChangeWidget(Id(:count), :Value, "#{@count} items")
+
+      UI.UserInput
+
+      UI.CloseDialog
+
+      nil
+    end
+  end
+end
+
+Yast::TableLazyItemsClient.new.main
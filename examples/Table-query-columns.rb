@@ -0,0 +1,40 @@
+# encoding: utf-8
+
+# Example for querying only some columns or only the IDs of Table items
+module Yast
+  class TableQueryColumnsClient < Client
+    def main
+      Yast.import "UI"
+
+      UI.OpenDialog(
+        VBox(
+          Table(
+            Id(:table),
+            Header("Name", "Version", "Summary"),
+            [
+              Item(Id("yast2"), "yast2", "4.5.1", "YaST2 main package"),
+              Item(Id("libyui"), "libyui", "4.3.3", "GUI-abstraction library"),
+              Item(Id("ruby"), "ruby", "3.3", "An interpreted scripting language")
+            ]
+          ),
+          PushButton(Id(:close), "&Close")
+        )
+      )
+
+      # Only names and summaries
+      @items = UI.QueryWidget(Id(:table), Term(:Items, :columns, [0, 2]))
+      Builtins.y2milestone("Items: %1", @items)
+
+      # Only IDs
+      @ids = UI.QueryWidget(Id(:table), :ItemIds)
+      Builtins.y2milestone("IDs: %1", @ids)
+
+      UI.UserInput
+      UI.CloseDialog
+
+      nil
+    end
+  end
+end
+
+Yast::TableQueryColumnsClient.new.main
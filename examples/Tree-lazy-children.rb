@@ -0,0 +1,49 @@
+# encoding: utf-8
+
+# Example for lazy tree items: Supply the children of an item only when the
+# user opens it
+module Yast
+  class TreeLazyChildrenClient < Client
+    def main
+      Yast.import "UI"
+
+      UI.OpenDialog(
+        VBox(
+          MinSize(
+            40,
+            15,
+            Tree(Id(:tree), "&Directories", [Item(Id("/"), "/", :lazy)])
+          ),
+          Right(PushButton(Id(:close), "&Close"))
+        )
+      )
+
+      loop do
+        @event = UI.WaitForEvent
+        @id = @event["ID"]
+
+        if @id == :tree && @event["EventReason"] == "Expanded"
+          @dir = @event["ItemID"]
+          UI.ChangeWidget(Id(:tree), Children(@dir), subdir_items(@dir))
+        elsif @id == :close || @id == :cancel
+          break
+        end
+      end
+
+      UI.CloseDialog
+
+      nil
+    end
+
+    # Items for all subdirectories of a directory, each with lazy children
+    def subdir_items(dir)
+      subdirs = Dir.children(dir).sort.map { |name| File.join(dir, name) }
+      subdirs.select! { |path| File.directory?(path) && !File.symlink?(path) }
+      subdirs.map { |path| Item(Id(path), File.basename(path), :lazy) }
+    rescue SystemCallError
+      []
+    end
+  end
+end
+
+Yast::TreeLazyChildrenClient.new.main
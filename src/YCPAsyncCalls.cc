@@ -0,0 +1,227 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPAsyncCalls.cc
+
+		Queue for UI builtin calls whose result is not needed.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#define y2log_component "ui"
+#include <ycp/y2log.h>
+
+#include <ycp/YCPBoolean.h>
+#include <ycp/YCPInteger.h>
+#include <ycp/YCPString.h>
+#include <ycp/YCPSymbol.h>
+#include <ycp/YCPTerm.h>
+#include <ycp/YCPVoid.h>
+
+#include <yui/YUI.h>
+#include <yui/YUIException.h>
+#include <yui/YUISymbols.h>
+
+#include "YCPAsyncCalls.h"
+#include "YCPBuiltinCaller.h"
+#include "YUINamespace.h"
+
+// Execute the queued calls when there are that many
+#define MAX_QUEUED_CALLS	256
+
+// Execute the queued calls when another one is queued and the first one
+// has waited that long
+#define MAX_DELAY_MILLISEC	100
+
+
+std::atomic<bool>			YCPAsyncCalls::_enabled( false );
+std::vector<YUIFunction *>		YCPAsyncCalls::_queue;
+std::chrono::steady_clock::time_point	YCPAsyncCalls::_firstQueued;
+
+long					YCPAsyncCalls::_queuedCount   = 0;
+long					YCPAsyncCalls::_executedCount = 0;
+std::map<string, long>			YCPAsyncCalls::_coalescedCount;
+
+
+YCPValue
+YCPAsyncCalls::queuedResult( const string & name )
+{
+    if ( name == YUIBuiltin_ChangeWidget ||
+	 name == "WizardCommand" )
+    {
+	return YCPBoolean( true );
+    }
+
+    if ( name == "BusyCursor"   ||
+	 name == "NormalCursor" ||
+	 name == "Beep" )
+    {
+	return YCPVoid();
+    }
+
+    return YCPNull();
+}
+
+
+bool
+YCPAsyncCalls::mayCoalesce( const string & name )
+{
+    return name == YUIBuiltin_ChangeWidget;
+}
+
+
+void
+YCPAsyncCalls::add( YUI * ui, YUIFunction * function, bool coalesce )
+{
+    if ( _queue.empty() )
+    {
+	_queue.reserve( MAX_QUEUED_CALLS );
+	_firstQueued = std::chrono::steady_clock::now();
+    }
+
+    YCPValue widgetId = YCPNull();
+    string   property;
+
+    if ( coalesce && coalesceKey( function, widgetId, property ) )
+    {
+	// Drop the last queued call that changes the same widget property.
+	// The new call goes to the end of the queue, so the order of all
+	// changes that are actually executed stays the same.
+
+	for ( int i = _queue.size() - 1; i >= 0; i-- )
+	{
+	    YCPValue queuedId = YCPNull();
+	    string   queuedProperty;
+
+	    if ( coalesceKey( _queue[i], queuedId, queuedProperty ) &&
+		 queuedProperty == property &&
+		 queuedId->equal( widgetId ) )
+	    {
+		delete _queue[i];
+		_queue.erase( _queue.begin() + i );
+		_coalescedCount[ property ]++;
+		break; // there can't be any more: they would have been dropped, too
+	    }
+	}
+    }
+
+    _queue.push_back( function );
+    _queuedCount++;
+
+    long waiting = std::chrono::duration_cast<std::chrono::milliseconds>
+	( std::chrono::steady_clock::now() - _firstQueued ).count();
+
+    if ( _queue.size() >= MAX_QUEUED_CALLS || waiting >= MAX_DELAY_MILLISEC )
+	flush( ui );
+}
+
+
+void
+YCPAsyncCalls::flush( YUI * ui )
+{
+    if ( _queue.empty() )
+	return;
+
+    // Take the queue over first: Any builtin call from within these calls
+    // must not flush it again.
+
+    std::vector<YUIFunction *> queue;
+    queue.swap( _queue );
+    _executedCount += queue.size();
+
+    try
+    {
+	if ( ui->runningWithThreads() )
+	{
+	    YCPBuiltinCaller::builtinCaller( ui )->callInUIThread( ui, queue );
+	}
+	else
+	{
+	    for ( size_t i=0; i < queue.size(); i++ )
+		queue[i]->evaluateCall_int();
+	}
+    }
+    catch ( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+	y2error( "Executing %zu queued UI calls failed", queue.size() );
+    }
+
+    for ( size_t i=0; i < queue.size(); i++ )
+	delete queue[i];
+}
+
+
+YCPMap
+YCPAsyncCalls::stats()
+{
+    YCPMap coalescedByProperty;
+    long   coalesced = 0;
+
+    for ( std::map<string, long>::const_iterator it = _coalescedCount.begin();
+	  it != _coalescedCount.end();
+	  ++it )
+    {
+	coalescedByProperty->add( YCPString( it->first ), YCPInteger( it->second ) );
+	coalesced += it->second;
+    }
+
+    YCPMap stats;
+    stats->add( YCPString( "queued"	), YCPInteger( _queuedCount   ) );
+    stats->add( YCPString( "executed"	), YCPInteger( _executedCount ) );
+    stats->add( YCPString( "coalesced"	), YCPInteger( coalesced      ) );
+    stats->add( YCPString( "coalesced_by_property" ), coalescedByProperty );
+
+    return stats;
+}
+
+
+bool
+YCPAsyncCalls::coalesceKey( const YUIFunction *	function,
+			    YCPValue &		widgetId,
+			    string &		property )
+{
+    // ChangeWidget( widgetId, `property, newValue )
+
+    YCPValue id	  = function->parameter( 0 );
+    YCPValue prop = function->parameter( 1 );
+
+    if ( id.isNull() || prop.isNull() || ! prop->isSymbol() )
+	return false;
+
+    property = prop->asSymbol()->symbol();
+
+    if ( property != YUIProperty_Value &&
+	 property != YUIProperty_Label &&
+	 property != YUIProperty_Values )
+    {
+	return false;
+    }
+
+    if ( id->isTerm() && id->asTerm()->name() == YUISymbol_id )	// `id(..) ?
+	id = id->asTerm()->value(0);
+
+    widgetId = id;
+
+    return true;
+}
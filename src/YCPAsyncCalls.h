@@ -0,0 +1,154 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPAsyncCalls.h
+
+		Queue for UI builtin calls whose result is not needed.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPAsyncCalls_h
+#define YCPAsyncCalls_h
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <ycp/YCPValue.h>
+#include <ycp/YCPMap.h>
+
+using std::string;
+
+class YUI;
+class YUIFunction;
+
+
+/**
+ * Queue for "fire and forget" UI builtin calls (ChangeWidget, BusyCursor,
+ * NormalCursor, Beep, WizardCommand) in async mode (UI::SetAsyncMode()).
+ *
+ * In async mode, such calls are not executed right away, but queued; they
+ * immediately return a fixed result (true or nil). All queued calls are
+ * executed in the order they were made, and always before any other UI
+ * builtin call, so any call whose result is needed (UserInput, QueryWidget
+ * etc.) sees all the changes. When the UI runs in a separate thread, all
+ * queued calls are handed over to it at once, so a whole series of them
+ * costs only one round trip to the UI thread.
+ *
+ * The queue is also executed when it is full or when another call is
+ * queued and the first one has waited for too long, so progress updates
+ * still show up regularly in a loop of UI calls. There is no timer: The
+ * queued calls and their YCP values belong to the interpreter thread, so
+ * they can't be executed while that thread does something else.
+ * Applications have to call UI::FlushAsyncCalls() before long operations
+ * without UI calls.
+ *
+ * A queued ChangeWidget call for the Value, Label or Values property is
+ * dropped when another call for the same widget and property is queued:
+ * Only the latest value would be visible anyway.
+ **/
+class YCPAsyncCalls
+{
+public:
+
+    /**
+     * Enable or disable async mode.
+     **/
+    static void setEnabled( bool enabled ) { _enabled = enabled; }
+
+    /**
+     * Return 'true' if async mode is enabled.
+     **/
+    static bool enabled() { return _enabled; }
+
+    /**
+     * Return the result that a call of builtin 'name' returns when it is
+     * queued or YCPNull if such calls can't be queued at all.
+     **/
+    static YCPValue queuedResult( const string & name );
+
+    /**
+     * Return 'true' if queued calls of builtin 'name' may be replaced by
+     * later calls that change the same thing.
+     **/
+    static bool mayCoalesce( const string & name );
+
+    /**
+     * Add 'function' (a copy that is not used by the interpreter anymore)
+     * to the queue. This class takes over ownership of it. If 'coalesce' is
+     * true, drop a queued call that changes the same widget property.
+     *
+     * Execute all queued calls if the queue is full or too old. This is the
+     * only place where the age of the queue is checked.
+     **/
+    static void add( YUI * ui, YUIFunction * function, bool coalesce );
+
+    /**
+     * Execute all queued calls in the order they were queued.
+     **/
+    static void flush( YUI * ui );
+
+    /**
+     * Return 'true' if there are no queued calls.
+     **/
+    static bool isEmpty() { return _queue.empty(); }
+
+    /**
+     * Return statistics: The number of queued, executed and dropped
+     * (coalesced) calls since the UI was started, and the number of
+     * dropped calls for each property:
+     *
+     *     $[ "queued": 2000, "executed": 200, "coalesced": 1800,
+     *        "coalesced_by_property": $[ "Value": 1000, "Label": 800 ] ]
+     **/
+    static YCPMap stats();
+
+private:
+
+    /**
+     * Return the widget ID and property changed by a queued ChangeWidget
+     * call in 'widgetId' and 'property' if such a call may be dropped in
+     * favor of a later one. Return 'false' if it may not.
+     **/
+    static bool coalesceKey( const YUIFunction *	function,
+			     YCPValue &			widgetId,
+			     string &			property );
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPAsyncCalls() {}
+
+    static std::atomic<bool>			_enabled;
+    static std::vector<YUIFunction *>		_queue;
+    static std::chrono::steady_clock::time_point _firstQueued;
+
+    static long					_queuedCount;
+    static long					_executedCount;
+    static std::map<string, long>		_coalescedCount;
+};
+
+
+#endif // YCPAsyncCalls_h
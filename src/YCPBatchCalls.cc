@@ -0,0 +1,173 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPBatchCalls.cc
+
+		UI builtin calls that are recorded and executed as one batch.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#define y2log_component "ui"
+#include <ycp/y2log.h>
+
+#include <ycp/YCPVoid.h>
+
+#include <yui/YUI.h>
+#include <yui/YDialog.h>
+#include <yui/YUIException.h>
+#include <yui/YUISymbols.h>
+
+#include "YCPBatchCalls.h"
+#include "YUINamespace.h"
+
+
+bool					YCPBatchCalls::_recording = false;
+std::vector<YCPBatchCalls::Call>	YCPBatchCalls::_calls;
+
+
+void
+YCPBatchCalls::begin()
+{
+    if ( _recording )
+    {
+	y2error( "UI::BeginBatch() without UI::EndBatch() for the previous batch" );
+	executePending();
+    }
+
+    _recording = true;
+}
+
+
+bool
+YCPBatchCalls::mayRecord( const string & name )
+{
+    return name != YUIBuiltin_UserInput		&&
+	name != YUIBuiltin_TimeoutUserInput	&&
+	name != YUIBuiltin_WaitForEvent		&&
+	name != YUIBuiltin_PollInput		&&
+	name != "CloseUI"			&&
+	name != "BeginBatch"			&&
+	name != "EndBatch";
+}
+
+
+bool
+YCPBatchCalls::isBarrier( const string & name )
+{
+    return name == YUIBuiltin_OpenDialog	||
+	name == YUIBuiltin_CloseDialog		||
+	name == "OpenUI";
+}
+
+
+bool
+YCPBatchCalls::endsBatch( const string & name )
+{
+    return name == YUIBuiltin_UserInput		||
+	name == YUIBuiltin_TimeoutUserInput	||
+	name == YUIBuiltin_WaitForEvent		||
+	name == YUIBuiltin_PollInput		||
+	name == "CloseUI";
+}
+
+
+void
+YCPBatchCalls::add( YUIFunction * function, bool barrier )
+{
+    _calls.push_back( Call( function, barrier ) );
+}
+
+
+YCPList
+YCPBatchCalls::execute()
+{
+    if ( ! _recording )
+	y2error( "UI::EndBatch() without UI::BeginBatch()" );
+
+    _recording = false;
+
+    std::vector<Call> calls;
+    calls.swap( _calls );
+
+    YCPList   results;
+    YDialog * dialog = 0; // the dialog with delayed screen updates
+
+    YUI::ui()->blockEvents();	// We don't want self-generated events from the batch
+
+    try
+    {
+	for ( size_t i=0; i < calls.size(); i++ )
+	{
+	    // Never delay the screen updates of a dialog across calls that
+	    // might delete it
+
+	    if ( calls[i].barrier && dialog )
+	    {
+		dialog->doneMultipleChanges();
+		dialog = 0;
+	    }
+	    else if ( ! calls[i].barrier && ! dialog )
+	    {
+		dialog = YDialog::currentDialog( false ); // don't throw
+
+		if ( dialog )
+		    dialog->startMultipleChanges();
+	    }
+
+	    YCPValue result = calls[i].function->evaluateCall_int();
+	    results->add( result.isNull() ? YCPVoid() : result );
+	}
+    }
+    catch ( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+	y2error( "UI::EndBatch(): call #%d of %d failed", results->size(), (int) calls.size() );
+    }
+
+    // Keep one result for each call so they still match
+
+    while ( results->size() < (int) calls.size() )
+	results->add( YCPVoid() );
+
+    if ( dialog )
+	dialog->doneMultipleChanges();
+
+    YUI::ui()->unblockEvents();
+
+    for ( size_t i=0; i < calls.size(); i++ )
+	delete calls[i].function;
+
+    return results;
+}
+
+
+void
+YCPBatchCalls::executePending()
+{
+    if ( ! _recording )
+	return;
+
+    y2error( "Missing UI::EndBatch(): Executing %zu recorded UI calls now", _calls.size() );
+    execute();
+}
@@ -0,0 +1,136 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPBatchCalls.h
+
+		UI builtin calls that are recorded and executed as one batch.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPBatchCalls_h
+#define YCPBatchCalls_h
+
+#include <string>
+#include <vector>
+#include <ycp/YCPList.h>
+
+using std::string;
+
+class YUIFunction;
+
+
+/**
+ * Batches of UI builtin calls between UI::BeginBatch() and UI::EndBatch():
+ * The calls in between are only recorded (they return nil), and EndBatch()
+ * executes all of them in one go and returns the list of their results.
+ *
+ * When the UI runs in a separate thread, the whole batch costs only one
+ * round trip to the UI thread (the one of EndBatch()). The calls are
+ * executed with events blocked and with the screen updates of the current
+ * dialog delayed until the end of the batch (or until the next OpenDialog()
+ * or CloseDialog() in the batch).
+ *
+ * Calls that wait for user input and CloseUI() are never recorded. If a batch
+ * is still being recorded when one of them is made (e.g. because the
+ * application left the code between BeginBatch() and EndBatch() with an
+ * exception), that batch is executed first, so no UI calls get lost and the
+ * order of all calls stays the same. The same happens for a BeginBatch()
+ * while a batch is being recorded.
+ **/
+class YCPBatchCalls
+{
+public:
+
+    /**
+     * Start recording. If a batch is already being recorded, log an error
+     * and execute that batch first.
+     **/
+    static void begin();
+
+    /**
+     * Return 'true' if calls are being recorded.
+     **/
+    static bool recording() { return _recording; }
+
+    /**
+     * Return 'true' if calls of builtin 'name' may be recorded. Calls that
+     * wait for events or that control batches never are.
+     **/
+    static bool mayRecord( const string & name );
+
+    /**
+     * Return 'true' if calls of builtin 'name' create or delete dialogs:
+     * Screen updates can't be delayed across such calls.
+     **/
+    static bool isBarrier( const string & name );
+
+    /**
+     * Return 'true' if calls of builtin 'name' wait for user input or shut
+     * down the UI: A batch that is still being recorded must be executed
+     * before such a call.
+     **/
+    static bool endsBatch( const string & name );
+
+    /**
+     * Add 'function' (a copy that is not used by the interpreter anymore)
+     * to the batch. This class takes over ownership of it.
+     **/
+    static void add( YUIFunction * function, bool barrier );
+
+    /**
+     * Stop recording, execute all recorded calls in order and return the
+     * list of their results. This list always has one entry for each
+     * recorded call; if one of them fails, it and all remaining calls are
+     * not executed, and their results are nil.
+     **/
+    static YCPList execute();
+
+    /**
+     * Log an error and execute a batch that is still being recorded. Its
+     * results are lost. Do nothing if no batch is being recorded.
+     **/
+    static void executePending();
+
+private:
+
+    struct Call
+    {
+	Call( YUIFunction * f, bool b )
+	    : function( f ), barrier( b ) {}
+
+	YUIFunction *	function;
+	bool		barrier;
+    };
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPBatchCalls() {}
+
+    static bool			_recording;
+    static std::vector<Call>	_calls;
+};
+
+
+#endif // YCPBatchCalls_h
@@ -27,9 +27,24 @@ you may find current contact information at www.novell.com
 /-*/
 
 
+#include <sched.h>
+#include <unistd.h>
+
+#define y2log_component "ui"
+#include <ycp/y2log.h>
+#include <ycp/YCPVoid.h>
+
+#include <yui/YUI.h>
+
 #include "YCPBuiltinCaller.h"
 #include "YUINamespace.h"
 
+// Retry a failed wait for the UI thread that often without sleeping
+#define MAX_FAST_RETRIES	100
+
+// Sleep that long between any further retries
+#define RETRY_SLEEP_MICROSEC	1000
+
 
 void
 YCPBuiltinCaller::call()
@@ -38,5 +53,94 @@ YCPBuiltinCaller::call()
     {
 	_result   = _function->evaluateCall_int();
 	_function = 0; // make sure this function is only called once
+	_done.store( true, std::memory_order_release );
+    }
+    else if ( _functions )
+    {
+	for ( size_t i=0; i < _functions->size(); i++ )
+	    _result = (*_functions)[i]->evaluateCall_int();
+
+	_functions = 0;
+	_done.store( true, std::memory_order_release );
+    }
+}
+
+
+YCPBuiltinCaller *
+YCPBuiltinCaller::builtinCaller( YUI * ui )
+{
+    YCPBuiltinCaller * caller = dynamic_cast<YCPBuiltinCaller *> ( ui->builtinCaller() );
+
+    if ( ! caller )
+    {
+	caller = new YCPBuiltinCaller();
+	ui->setBuiltinCaller( caller );
+    }
+
+    return caller;
+}
+
+
+YCPValue
+YCPBuiltinCaller::callInUIThread( YUI * ui, YUIFunction * function )
+{
+    setFunction( function );
+
+    return handOff( ui );
+}
+
+
+YCPValue
+YCPBuiltinCaller::callInUIThread( YUI * ui, const std::vector<YUIFunction *> & functions )
+{
+    _functions = &functions;
+
+    return handOff( ui );
+}
+
+
+YCPValue
+YCPBuiltinCaller::handOff( YUI * ui )
+{
+    _done.store( false, std::memory_order_relaxed );
+    _result = YCPVoid();
+
+    ui->signalUIThread();
+
+    // waitForUIThread() blocks until the UI thread answers through its pipe.
+    // It returns 'false' only if it was interrupted or if reading failed.
+    // Retrying that immediately in a tight loop might keep a CPU core busy
+    // for as long as the UI thread needs, so back off after a while.
+    //
+    // Don't stop waiting before the answer was read, even if the call is
+    // done(): The next call would then get this answer.
+
+    int failures = 0;
+
+    while ( ! ui->waitForUIThread() )
+    {
+	if ( ++failures <= MAX_FAST_RETRIES )
+	{
+	    sched_yield();
+	}
+	else
+	{
+	    if ( failures == MAX_FAST_RETRIES + 1 )
+		y2warning( "Still waiting for the UI thread after %d failed attempts", failures );
+
+	    usleep( RETRY_SLEEP_MICROSEC );
+	}
     }
+
+    if ( ! done() )
+    {
+	// Don't return the result of a previous call
+
+	y2error( "UI thread answered without calling the builtin" );
+	_function  = 0;
+	_functions = 0;
+	return YCPVoid();
+    }
+
+    return _result;
 }
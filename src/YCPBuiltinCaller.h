@@ -29,10 +29,13 @@ you may find current contact information at www.novell.com
 #ifndef YCPBuiltinCaller_h
 #define YCPBuiltinCaller_h
 
+#include <atomic>
+#include <vector>
 #include <yui/YBuiltinCaller.h>
 #include "ycp/YCPValue.h"
 
 class YUIFunction;
+class YUI;
 
 
 /**
@@ -44,6 +47,8 @@ class YCPBuiltinCaller: public YBuiltinCaller
 public:
     YCPBuiltinCaller()
 	: _function(0)
+	, _functions(0)
+	, _done( false )
 	{}
     
     virtual ~YCPBuiltinCaller() {}
@@ -60,6 +65,31 @@ public:
      **/
     virtual void call();
 
+    /**
+     * Hand 'function' over to the UI thread of 'ui', wait until the UI thread
+     * has called it and return its result.
+     **/
+    YCPValue callInUIThread( YUI * ui, YUIFunction * function );
+
+    /**
+     * Hand all of 'functions' over to the UI thread of 'ui' at once, wait
+     * until the UI thread has called all of them in that order and return
+     * the result of the last one.
+     **/
+    YCPValue callInUIThread( YUI * ui, const std::vector<YUIFunction *> & functions );
+
+    /**
+     * Return the YCPBuiltinCaller of 'ui'. Create one if it doesn't have
+     * one yet.
+     **/
+    static YCPBuiltinCaller * builtinCaller( YUI * ui );
+
+    /**
+     * Return 'true' if the function set with setFunction() was called.
+     * This is safe to use from any thread.
+     **/
+    bool done() const { return _done.load( std::memory_order_acquire ); }
+
     /**
      * Return the result of the last call.
      **/
@@ -67,8 +97,15 @@ public:
 
 private:
 
-    YUIFunction *	_function;
-    YCPValue		_result;
+    /**
+     * Signal the UI thread of 'ui' to call the function(s) and wait for it.
+     **/
+    YCPValue handOff( YUI * ui );
+
+    YUIFunction *			_function;
+    const std::vector<YUIFunction *> *	_functions;
+    YCPValue				_result;
+    std::atomic<bool>			_done;
 };
 
 
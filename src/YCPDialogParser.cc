@@ -30,6 +30,9 @@ you may find current contact information at www.novell.com
 
 
 #include <string.h>		// strncasecmp()
+#include <stdlib.h>		// atoi()
+#include <ctype.h>		// isdigit()
+#include <unordered_map>
 
 #include <ycp/YCPString.h>
 #include <ycp/YCPVoid.h>
@@ -47,10 +50,13 @@ you may find current contact information at www.novell.com
 #include "YCPDialogParser.h"
 
 #include "YCPItemParser.h"
+#include "YCPLazyTableItems.h"
+#include "YCPLazyTreeItems.h"
 #include "YCPMenuItemParser.h"
 #include "YCPTableItemParser.h"
 #include "YCPTreeItemParser.h"
 #include "YCPValueWidgetID.h"
+#include "YCPWidgetIdIndex.h"
 #include "YCP_UI_Exception.h"
 #include "YCP_util.h"
 #include "YWidgetOpt.h"
@@ -204,42 +210,8 @@ YCPDialogParser::parseWidgetTreeTerm( YWidget *		p,
     {
 	if ( rawopt->value(o)->isSymbol() )
 	{
-	    string sym = rawopt->value(o)->asSymbol()->symbol();
-	    if	    ( sym == YUIOpt_notify              )  opt.notifyMode.setValue( true );
-	    else if ( sym == YUIOpt_notifyContextMenu   )  opt.notifyContextMenu.setValue( true );
-	    else if ( sym == YUIOpt_disabled	        )  opt.isDisabled.setValue( true );
-	    else if ( sym == YUIOpt_hstretch	        )  opt.isHStretchable.setValue( true );
-	    else if ( sym == YUIOpt_vstretch	        )  opt.isVStretchable.setValue( true );
-	    else if ( sym == YUIOpt_hvstretch	        )  { opt.isHStretchable.setValue( true ); opt.isVStretchable.setValue( true ); }
-	    else if ( sym == YUIOpt_autoShortcut        )  opt.autoShortcut.setValue( true );
-	    else if ( sym == YUIOpt_boldFont	        )  opt.boldFont.setValue( true );
-	    else if ( sym == YUIOpt_keyEvents	        )  opt.keyEvents.setValue( true );
-	    else if ( sym == YUIOpt_key_F1	        )  opt.key_Fxx.setValue(  1 );
-	    else if ( sym == YUIOpt_key_F2	        )  opt.key_Fxx.setValue(  2 );
-	    else if ( sym == YUIOpt_key_F3	        )  opt.key_Fxx.setValue(  3 );
-	    else if ( sym == YUIOpt_key_F4	        )  opt.key_Fxx.setValue(  4 );
-	    else if ( sym == YUIOpt_key_F5	        )  opt.key_Fxx.setValue(  5 );
-	    else if ( sym == YUIOpt_key_F6	        )  opt.key_Fxx.setValue(  6 );
-	    else if ( sym == YUIOpt_key_F7	        )  opt.key_Fxx.setValue(  7 );
-	    else if ( sym == YUIOpt_key_F8	        )  opt.key_Fxx.setValue(  8 );
-	    else if ( sym == YUIOpt_key_F9	        )  opt.key_Fxx.setValue(  9 );
-	    else if ( sym == YUIOpt_key_F10	        )  opt.key_Fxx.setValue( 10 );
-	    else if ( sym == YUIOpt_key_F11	        )  opt.key_Fxx.setValue( 11 );
-	    else if ( sym == YUIOpt_key_F12	        )  opt.key_Fxx.setValue( 12 );
-	    else if ( sym == YUIOpt_key_F13	        )  opt.key_Fxx.setValue( 13 );
-	    else if ( sym == YUIOpt_key_F14	        )  opt.key_Fxx.setValue( 14 );
-	    else if ( sym == YUIOpt_key_F15	        )  opt.key_Fxx.setValue( 15 );
-	    else if ( sym == YUIOpt_key_F16	        )  opt.key_Fxx.setValue( 16 );
-	    else if ( sym == YUIOpt_key_F17	        )  opt.key_Fxx.setValue( 17 );
-	    else if ( sym == YUIOpt_key_F18	        )  opt.key_Fxx.setValue( 18 );
-	    else if ( sym == YUIOpt_key_F19	        )  opt.key_Fxx.setValue( 19 );
-	    else if ( sym == YUIOpt_key_F20	        )  opt.key_Fxx.setValue( 20 );
-	    else if ( sym == YUIOpt_key_F21	        )  opt.key_Fxx.setValue( 21 );
-	    else if ( sym == YUIOpt_key_F22	        )  opt.key_Fxx.setValue( 22 );
-	    else if ( sym == YUIOpt_key_F23	        )  opt.key_Fxx.setValue( 23 );
-	    else if ( sym == YUIOpt_key_F24	        )  opt.key_Fxx.setValue( 24 );
-	    else if ( sym == YUIOpt_key_none	        )  opt.key_Fxx.setValue( -1 );
-	    else ol->add( rawopt->value(o) );
+	    if ( ! applyGenericOption( opt, rawopt->value(o)->asSymbol()->symbol_cstr() ) )
+		ol->add( rawopt->value(o) );
 	}
 	else if ( ! rawopt->value(o)->isTerm() )
 	{
@@ -257,91 +229,15 @@ YCPDialogParser::parseWidgetTreeTerm( YWidget *		p,
     YWidget * w	= 0;
     string    s	= term->name();
 
-    // If you add a new widget here, make sure to also adapt ui_shortcuts.rb
-    // in the yast-ruby-bindings package!
-    //
-    // https://github.com/yast/yast-ruby-bindings/blob/master/src/ruby/yast/ui_shortcuts.rb
+    WidgetParser parser = widgetParser( s );
 
-    if	    ( s == YUIWidget_Bottom		)	w = parseAlignment		( p, opt, term, ol, n, YAlignUnchanged,	YAlignEnd	);
-    else if ( s == YUIWidget_BusyIndicator	)	w = parseBusyIndicator		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_ButtonBox		)	w = parseButtonBox		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_CheckBox		)	w = parseCheckBox		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_CheckBoxFrame	)	w = parseCheckBoxFrame		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_ComboBox		)	w = parseComboBox		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_CustomStatusItemSelector )	w = parseCustomStatusItemSelector( p, opt, term, ol, n );
-    else if ( s == YUIWidget_Empty		)	w = parseEmpty			( p, opt, term, ol, n );
-    else if ( s == YUIWidget_Frame		)	w = parseFrame			( p, opt, term, ol, n );
-    else if ( s == YUIWidget_HBox		)	w = parseLayoutBox		( p, opt, term, ol, n, YD_HORIZ );
-    else if ( s == YUIWidget_HCenter		)	w = parseAlignment		( p, opt, term, ol, n, YAlignCenter,	YAlignUnchanged );
-    else if ( s == YUIWidget_HSpacing		)	w = parseSpacing		( p, opt, term, ol, n, YD_HORIZ, false );
-    else if ( s == YUIWidget_HSquash		)	w = parseSquash			( p, opt, term, ol, n, true,  false );
-    else if ( s == YUIWidget_HStretch		)	w = parseSpacing		( p, opt, term, ol, n, YD_HORIZ, true );
-    else if ( s == YUIWidget_HVCenter		)	w = parseAlignment		( p, opt, term, ol, n, YAlignCenter,	YAlignCenter	);
-    else if ( s == YUIWidget_HVSquash		)	w = parseSquash			( p, opt, term, ol, n, true,  true );
-    else if ( s == YUIWidget_HWeight		)	w = parseWeight			( p, opt, term, ol, n, YD_HORIZ );
-    else if ( s == YUIWidget_Heading		)	w = parseLabel			( p, opt, term, ol, n, true );
-    else if ( s == YUIWidget_IconButton		)	w = parsePushButton		( p, opt, term, ol, n, true );
-    else if ( s == YUIWidget_Image		)	w = parseImage			( p, opt, term, ol, n );
-    else if ( s == YUIWidget_InputField		)	w = parseInputField		( p, opt, term, ol, n, false );
-    else if ( s == YUIWidget_IntField		)	w = parseIntField		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_Label		)	w = parseLabel			( p, opt, term, ol, n, false );
-    else if ( s == YUIWidget_Left		)	w = parseAlignment		( p, opt, term, ol, n, YAlignBegin,	YAlignUnchanged );
-    else if ( s == YUIWidget_LogView		)	w = parseLogView		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_MarginBox		)	w = parseMarginBox		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_MenuBar		)	w = parseMenuBar		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_MenuButton		)	w = parseMenuButton		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_MinHeight		)	w = parseMinSize		( p, opt, term, ol, n, false, true  );
-    else if ( s == YUIWidget_MinSize		)	w = parseMinSize		( p, opt, term, ol, n, true,  true  );
-    else if ( s == YUIWidget_MinWidth		)	w = parseMinSize		( p, opt, term, ol, n, true,  false );
-    else if ( s == YUIWidget_MultiItemSelector  )	w = parseItemSelector           ( p, opt, term, ol, n, false );
-    else if ( s == YUIWidget_MultiLineEdit	)	w = parseMultiLineEdit		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_MultiSelectionBox	)	w = parseMultiSelectionBox	( p, opt, term, ol, n );
-    else if ( s == YUIWidget_PackageSelector	)	w = parsePackageSelector	( p, opt, term, ol, n );
-    else if ( s == YUIWidget_Password		)	w = parseInputField		( p, opt, term, ol, n, true );
-    else if ( s == YUIWidget_PkgSpecial		)	w = parsePkgSpecial		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_ProgressBar	)	w = parseProgressBar		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_PushButton		)	w = parsePushButton		( p, opt, term, ol, n, false );
-    else if ( s == YUIWidget_RadioButton	)	w = parseRadioButton		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_RadioButtonGroup	)	w = parseRadioButtonGroup	( p, opt, term, ol, n );
-    else if ( s == YUIWidget_ReplacePoint	)	w = parseReplacePoint		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_RichText		)	w = parseRichText		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_Right		)	w = parseAlignment		( p, opt, term, ol, n, YAlignEnd,	YAlignUnchanged );
-    else if ( s == YUIWidget_SelectionBox	)	w = parseSelectionBox		( p, opt, term, ol, n );
-    else if ( s == YUIWidget_SingleItemSelector )	w = parseItemSelector           ( p, opt, term, ol, n, true );
-    else if ( s == YUIWidget_Table		)	w = parseTable			( p, opt, term, ol, n );
-    else if ( s == YUIWidget_TextEntry		)	w = parseInputField		( p, opt, term, ol, n, false, true ); // bugCompatibilityMode
-    else if ( s == YUIWidget_Top		)	w = parseAlignment		( p, opt, term, ol, n, YAlignUnchanged,	YAlignBegin	);
-    else if ( s == YUIWidget_Tree		)	w = parseTree			( p, opt, term, ol, n );
-    else if ( s == YUIWidget_VBox		)	w = parseLayoutBox		( p, opt, term, ol, n, YD_VERT );
-    else if ( s == YUIWidget_VCenter		)	w = parseAlignment		( p, opt, term, ol, n, YAlignUnchanged,	YAlignCenter	);
-    else if ( s == YUIWidget_VSpacing		)	w = parseSpacing		( p, opt, term, ol, n, YD_VERT, false );
-    else if ( s == YUIWidget_VSquash		)	w = parseSquash			( p, opt, term, ol, n, false, true );
-    else if ( s == YUIWidget_VStretch		)	w = parseSpacing		( p, opt, term, ol, n, YD_VERT, true );
-    else if ( s == YUIWidget_VWeight		)	w = parseWeight			( p, opt, term, ol, n, YD_VERT );
-
-    // Special widgets - may or may not be supported by the specific UI.
-    // The YCP application should ask for presence of such a widget with Has???Widget() prior to creating one.
-
-    else if ( s == YUISpecialWidget_BarGraph		)	w = parseBarGraph		( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_DateField		)	w = parseDateField		( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_DownloadProgress	)	w = parseDownloadProgress	( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_DumbTab		)	w = parseDumbTab		( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_DummySpecialWidget	)	w = parseDummySpecialWidget	( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_Graph		)	w = parseGraph			( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_HMultiProgressMeter	)	w = parseMultiProgressMeter	( p, opt, term, ol, n, YD_HORIZ );
-    else if ( s == YUISpecialWidget_PartitionSplitter	)	w = parsePartitionSplitter	( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_PatternSelector	)	w = parsePatternSelector	( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_SimplePatchSelector	)	w = parseSimplePatchSelector	( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_Slider		)	w = parseSlider			( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_TimeField		)	w = parseTimeField		( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_TimezoneSelector	)	w = parseTimezoneSelector	( p, opt, term, ol, n );
-    else if ( s == YUISpecialWidget_VMultiProgressMeter	)	w = parseMultiProgressMeter	( p, opt, term, ol, n, YD_VERT	);
-    else if ( s == YUISpecialWidget_Wizard		)	w = parseWizard			( p, opt, term, ol, n );
-    else
+    if ( ! parser )
     {
 	YUI_THROW( YUIException( string( "Unknown widget type " ) + s.c_str() ) );
     }
 
+    w = parser( p, opt, term, ol, n );
+
 
     // Post-process the newly created widget
 
@@ -351,7 +247,10 @@ YCPDialogParser::parseWidgetTreeTerm( YWidget *		p,
 	     ! id->isVoid() )
 	{
 	    if ( ! w->hasId() )	// widget doesn't have an ID yet
+	    {
 		w->setId( new YCPValueWidgetID( id ) );
+		YCPWidgetIdIndex::addWidget( w->findDialog(), w );
+	    }
 
 	    /*
 	     * Note: Don't set the ID if it is already set!
@@ -399,6 +298,242 @@ YCPDialogParser::parseWidgetTreeTerm( YWidget *		p,
 }
 
 
+/**
+ * Hash and equality functors for using plain C strings as hash keys.
+ * This avoids creating a std::string for each option symbol.
+ **/
+struct CStringHash
+{
+    size_t operator()( const char * str ) const
+    {
+	// FNV-1a
+
+	size_t hash = 2166136261u;
+
+	while ( *str )
+	{
+	    hash ^= (unsigned char) *str++;
+	    hash *= 16777619u;
+	}
+
+	return hash;
+    }
+};
+
+
+struct CStringEqual
+{
+    bool operator()( const char * a, const char * b ) const
+    {
+	return strcmp( a, b ) == 0;
+    }
+};
+
+
+typedef void (*OptionSetter)( YWidgetOpt & opt );
+typedef std::unordered_map<const char *, OptionSetter, CStringHash, CStringEqual> OptionSetterMap;
+
+
+static OptionSetterMap
+createOptionSetterMap()
+{
+    // The key_F1 .. key_F24 options are decoded numerically in
+    // YCPDialogParser::applyGenericOption(), so they are not listed here.
+
+    static const struct
+    {
+	const char *	name;
+	OptionSetter	setter;
+    } table[] =
+    {
+	{ YUIOpt_notify,		[]( YWidgetOpt & opt ) { opt.notifyMode.setValue( true );		} },
+	{ YUIOpt_notifyContextMenu,	[]( YWidgetOpt & opt ) { opt.notifyContextMenu.setValue( true );	} },
+	{ YUIOpt_disabled,		[]( YWidgetOpt & opt ) { opt.isDisabled.setValue( true );		} },
+	{ YUIOpt_hstretch,		[]( YWidgetOpt & opt ) { opt.isHStretchable.setValue( true );		} },
+	{ YUIOpt_vstretch,		[]( YWidgetOpt & opt ) { opt.isVStretchable.setValue( true );		} },
+	{ YUIOpt_hvstretch,		[]( YWidgetOpt & opt ) { opt.isHStretchable.setValue( true );
+								 opt.isVStretchable.setValue( true );		} },
+	{ YUIOpt_autoShortcut,		[]( YWidgetOpt & opt ) { opt.autoShortcut.setValue( true );		} },
+	{ YUIOpt_boldFont,		[]( YWidgetOpt & opt ) { opt.boldFont.setValue( true );			} },
+	{ YUIOpt_keyEvents,		[]( YWidgetOpt & opt ) { opt.keyEvents.setValue( true );		} },
+	{ YUIOpt_key_none,		[]( YWidgetOpt & opt ) { opt.key_Fxx.setValue( -1 );			} }
+    };
+
+    OptionSetterMap setterMap;
+    setterMap.reserve( sizeof( table ) / sizeof( table[0] ) );
+
+    for ( size_t i=0; i < sizeof( table ) / sizeof( table[0] ); i++ )
+	setterMap[ table[i].name ] = table[i].setter;
+
+    return setterMap;
+}
+
+
+// Built once when the plugin is loaded; read-only afterwards
+static const OptionSetterMap optionSetterMap = createOptionSetterMap();
+
+
+bool
+YCPDialogParser::applyGenericOption( YWidgetOpt & opt, const char * optName )
+{
+    OptionSetterMap::const_iterator it = optionSetterMap.find( optName );
+
+    if ( it != optionSetterMap.end() )
+    {
+	it->second( opt );
+	return true;
+    }
+
+    // key_F1 .. key_F24
+
+    static const size_t prefixLen = strlen( YUIOpt_key_F1 ) - 1; // "key_F"
+
+    if ( strncmp( optName, YUIOpt_key_F1, prefixLen ) == 0 )
+    {
+	const char * digits = optName + prefixLen;
+
+	if ( isdigit( digits[0] ) && digits[0] != '0' &&
+	     ( digits[1] == '\0' || ( isdigit( digits[1] ) && digits[2] == '\0' ) ) )
+	{
+	    int key = atoi( digits );
+
+	    if ( key >= 1 && key <= 24 )
+	    {
+		opt.key_Fxx.setValue( key );
+		return true;
+	    }
+	}
+    }
+
+    return false;
+}
+
+
+/**
+ * Argument list of the widget parser lambdas in the dispatch table below.
+ **/
+#define WIDGET_PARSER_ARGS			\
+    ( YWidget *		p,			\
+      YWidgetOpt &	opt,			\
+      const YCPTerm &	term,			\
+      const YCPList &	ol,			\
+      int		n ) -> YWidget *
+
+
+YCPDialogParser::WidgetParserMap
+YCPDialogParser::createWidgetParserMap()
+{
+    // If you add a new widget here, make sure to also adapt ui_shortcuts.rb
+    // in the yast-ruby-bindings package!
+    //
+    // https://github.com/yast/yast-ruby-bindings/blob/master/src/ruby/yast/ui_shortcuts.rb
+
+    static const struct
+    {
+	const char *	name;
+	WidgetParser	parser;
+    } table[] =
+    {
+	{ YUIWidget_Bottom,                      [] WIDGET_PARSER_ARGS { return parseAlignment( p, opt, term, ol, n, YAlignUnchanged, YAlignEnd ); } },
+	{ YUIWidget_BusyIndicator,               [] WIDGET_PARSER_ARGS { return parseBusyIndicator( p, opt, term, ol, n ); } },
+	{ YUIWidget_ButtonBox,                   [] WIDGET_PARSER_ARGS { return parseButtonBox( p, opt, term, ol, n ); } },
+	{ YUIWidget_CheckBox,                    [] WIDGET_PARSER_ARGS { return parseCheckBox( p, opt, term, ol, n ); } },
+	{ YUIWidget_CheckBoxFrame,               [] WIDGET_PARSER_ARGS { return parseCheckBoxFrame( p, opt, term, ol, n ); } },
+	{ YUIWidget_ComboBox,                    [] WIDGET_PARSER_ARGS { return parseComboBox( p, opt, term, ol, n ); } },
+	{ YUIWidget_CustomStatusItemSelector,    [] WIDGET_PARSER_ARGS { return parseCustomStatusItemSelector( p, opt, term, ol, n ); } },
+	{ YUIWidget_Empty,                       [] WIDGET_PARSER_ARGS { return parseEmpty( p, opt, term, ol, n ); } },
+	{ YUIWidget_Frame,                       [] WIDGET_PARSER_ARGS { return parseFrame( p, opt, term, ol, n ); } },
+	{ YUIWidget_HBox,                        [] WIDGET_PARSER_ARGS { return parseLayoutBox( p, opt, term, ol, n, YD_HORIZ ); } },
+	{ YUIWidget_HCenter,                     [] WIDGET_PARSER_ARGS { return parseAlignment( p, opt, term, ol, n, YAlignCenter, YAlignUnchanged ); } },
+	{ YUIWidget_HSpacing,                    [] WIDGET_PARSER_ARGS { return parseSpacing( p, opt, term, ol, n, YD_HORIZ, false ); } },
+	{ YUIWidget_HSquash,                     [] WIDGET_PARSER_ARGS { return parseSquash( p, opt, term, ol, n, true, false ); } },
+	{ YUIWidget_HStretch,                    [] WIDGET_PARSER_ARGS { return parseSpacing( p, opt, term, ol, n, YD_HORIZ, true ); } },
+	{ YUIWidget_HVCenter,                    [] WIDGET_PARSER_ARGS { return parseAlignment( p, opt, term, ol, n, YAlignCenter, YAlignCenter ); } },
+	{ YUIWidget_HVSquash,                    [] WIDGET_PARSER_ARGS { return parseSquash( p, opt, term, ol, n, true, true ); } },
+	{ YUIWidget_HWeight,                     [] WIDGET_PARSER_ARGS { return parseWeight( p, opt, term, ol, n, YD_HORIZ ); } },
+	{ YUIWidget_Heading,                     [] WIDGET_PARSER_ARGS { return parseLabel( p, opt, term, ol, n, true ); } },
+	{ YUIWidget_IconButton,                  [] WIDGET_PARSER_ARGS { return parsePushButton( p, opt, term, ol, n, true ); } },
+	{ YUIWidget_Image,                       [] WIDGET_PARSER_ARGS { return parseImage( p, opt, term, ol, n ); } },
+	{ YUIWidget_InputField,                  [] WIDGET_PARSER_ARGS { return parseInputField( p, opt, term, ol, n, false ); } },
+	{ YUIWidget_IntField,                    [] WIDGET_PARSER_ARGS { return parseIntField( p, opt, term, ol, n ); } },
+	{ YUIWidget_Label,                       [] WIDGET_PARSER_ARGS { return parseLabel( p, opt, term, ol, n, false ); } },
+	{ YUIWidget_Left,                        [] WIDGET_PARSER_ARGS { return parseAlignment( p, opt, term, ol, n, YAlignBegin, YAlignUnchanged ); } },
+	{ YUIWidget_LogView,                     [] WIDGET_PARSER_ARGS { return parseLogView( p, opt, term, ol, n ); } },
+	{ YUIWidget_MarginBox,                   [] WIDGET_PARSER_ARGS { return parseMarginBox( p, opt, term, ol, n ); } },
+	{ YUIWidget_MenuBar,                     [] WIDGET_PARSER_ARGS { return parseMenuBar( p, opt, term, ol, n ); } },
+	{ YUIWidget_MenuButton,                  [] WIDGET_PARSER_ARGS { return parseMenuButton( p, opt, term, ol, n ); } },
+	{ YUIWidget_MinHeight,                   [] WIDGET_PARSER_ARGS { return parseMinSize( p, opt, term, ol, n, false, true ); } },
+	{ YUIWidget_MinSize,                     [] WIDGET_PARSER_ARGS { return parseMinSize( p, opt, term, ol, n, true, true ); } },
+	{ YUIWidget_MinWidth,                    [] WIDGET_PARSER_ARGS { return parseMinSize( p, opt, term, ol, n, true, false ); } },
+	{ YUIWidget_MultiItemSelector,           [] WIDGET_PARSER_ARGS { return parseItemSelector( p, opt, term, ol, n, false ); } },
+	{ YUIWidget_MultiLineEdit,               [] WIDGET_PARSER_ARGS { return parseMultiLineEdit( p, opt, term, ol, n ); } },
+	{ YUIWidget_MultiSelectionBox,           [] WIDGET_PARSER_ARGS { return parseMultiSelectionBox( p, opt, term, ol, n ); } },
+	{ YUIWidget_PackageSelector,             [] WIDGET_PARSER_ARGS { return parsePackageSelector( p, opt, term, ol, n ); } },
+	{ YUIWidget_Password,                    [] WIDGET_PARSER_ARGS { return parseInputField( p, opt, term, ol, n, true ); } },
+	{ YUIWidget_PkgSpecial,                  [] WIDGET_PARSER_ARGS { return parsePkgSpecial( p, opt, term, ol, n ); } },
+	{ YUIWidget_ProgressBar,                 [] WIDGET_PARSER_ARGS { return parseProgressBar( p, opt, term, ol, n ); } },
+	{ YUIWidget_PushButton,                  [] WIDGET_PARSER_ARGS { return parsePushButton( p, opt, term, ol, n, false ); } },
+	{ YUIWidget_RadioButton,                 [] WIDGET_PARSER_ARGS { return parseRadioButton( p, opt, term, ol, n ); } },
+	{ YUIWidget_RadioButtonGroup,            [] WIDGET_PARSER_ARGS { return parseRadioButtonGroup( p, opt, term, ol, n ); } },
+	{ YUIWidget_ReplacePoint,                [] WIDGET_PARSER_ARGS { return parseReplacePoint( p, opt, term, ol, n ); } },
+	{ YUIWidget_RichText,                    [] WIDGET_PARSER_ARGS { return parseRichText( p, opt, term, ol, n ); } },
+	{ YUIWidget_Right,                       [] WIDGET_PARSER_ARGS { return parseAlignment( p, opt, term, ol, n, YAlignEnd, YAlignUnchanged ); } },
+	{ YUIWidget_SelectionBox,                [] WIDGET_PARSER_ARGS { return parseSelectionBox( p, opt, term, ol, n ); } },
+	{ YUIWidget_SingleItemSelector,          [] WIDGET_PARSER_ARGS { return parseItemSelector( p, opt, term, ol, n, true ); } },
+	{ YUIWidget_Table,                       [] WIDGET_PARSER_ARGS { return parseTable( p, opt, term, ol, n ); } },
+	{ YUIWidget_TextEntry,                   [] WIDGET_PARSER_ARGS { return parseInputField( p, opt, term, ol, n, false, true ); } }, // bugCompatibilityMode
+	{ YUIWidget_Top,                         [] WIDGET_PARSER_ARGS { return parseAlignment( p, opt, term, ol, n, YAlignUnchanged, YAlignBegin ); } },
+	{ YUIWidget_Tree,                        [] WIDGET_PARSER_ARGS { return parseTree( p, opt, term, ol, n ); } },
+	{ YUIWidget_VBox,                        [] WIDGET_PARSER_ARGS { return parseLayoutBox( p, opt, term, ol, n, YD_VERT ); } },
+	{ YUIWidget_VCenter,                     [] WIDGET_PARSER_ARGS { return parseAlignment( p, opt, term, ol, n, YAlignUnchanged, YAlignCenter ); } },
+	{ YUIWidget_VSpacing,                    [] WIDGET_PARSER_ARGS { return parseSpacing( p, opt, term, ol, n, YD_VERT, false ); } },
+	{ YUIWidget_VSquash,                     [] WIDGET_PARSER_ARGS { return parseSquash( p, opt, term, ol, n, false, true ); } },
+	{ YUIWidget_VStretch,                    [] WIDGET_PARSER_ARGS { return parseSpacing( p, opt, term, ol, n, YD_VERT, true ); } },
+	{ YUIWidget_VWeight,                     [] WIDGET_PARSER_ARGS { return parseWeight( p, opt, term, ol, n, YD_VERT ); } },
+
+	// Special widgets - may or may not be supported by the specific UI.
+	// The YCP application should ask for presence of such a widget with Has???Widget() prior to creating one.
+
+	{ YUISpecialWidget_BarGraph,             [] WIDGET_PARSER_ARGS { return parseBarGraph( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_DateField,            [] WIDGET_PARSER_ARGS { return parseDateField( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_DownloadProgress,     [] WIDGET_PARSER_ARGS { return parseDownloadProgress( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_DumbTab,              [] WIDGET_PARSER_ARGS { return parseDumbTab( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_DummySpecialWidget,   [] WIDGET_PARSER_ARGS { return parseDummySpecialWidget( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_Graph,                [] WIDGET_PARSER_ARGS { return parseGraph( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_HMultiProgressMeter,  [] WIDGET_PARSER_ARGS { return parseMultiProgressMeter( p, opt, term, ol, n, YD_HORIZ ); } },
+	{ YUISpecialWidget_PartitionSplitter,    [] WIDGET_PARSER_ARGS { return parsePartitionSplitter( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_PatternSelector,      [] WIDGET_PARSER_ARGS { return parsePatternSelector( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_SimplePatchSelector,  [] WIDGET_PARSER_ARGS { return parseSimplePatchSelector( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_Slider,               [] WIDGET_PARSER_ARGS { return parseSlider( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_TimeField,            [] WIDGET_PARSER_ARGS { return parseTimeField( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_TimezoneSelector,     [] WIDGET_PARSER_ARGS { return parseTimezoneSelector( p, opt, term, ol, n ); } },
+	{ YUISpecialWidget_VMultiProgressMeter,  [] WIDGET_PARSER_ARGS { return parseMultiProgressMeter( p, opt, term, ol, n, YD_VERT ); } },
+	{ YUISpecialWidget_Wizard,               [] WIDGET_PARSER_ARGS { return parseWizard( p, opt, term, ol, n ); } },
+    };
+
+    WidgetParserMap parserMap;
+    parserMap.reserve( sizeof( table ) / sizeof( table[0] ) );
+
+    for ( size_t i=0; i < sizeof( table ) / sizeof( table[0] ); i++ )
+	parserMap[ table[i].name ] = table[i].parser;
+
+    return parserMap;
+}
+
+
+YCPDialogParser::WidgetParser
+YCPDialogParser::widgetParser( const string & widgetName )
+{
+    // Built only once on first use; read-only afterwards
+
+    static const WidgetParserMap parserMap = createWidgetParserMap();
+
+    WidgetParserMap::const_iterator it = parserMap.find( widgetName );
+
+    return it == parserMap.end() ? 0 : it->second;
+}
+
+
 /**
  * Overloaded version - just for convenience.
  * Most callers don't need to set up the widget options before calling, so this
@@ -2383,7 +2518,7 @@ YCPDialogParser::parseComboBox( YWidget * parent, YWidgetOpt & opt,
  *				[ Id( string  ),]
  *				string
  *				[ , true | false ]
- *				[ , itemList ]
+ *				[ , itemList | `lazy ]
  *			)
  *		</code>
  *
@@ -2400,6 +2535,7 @@ YCPDialogParser::parseComboBox( YWidget * parent, YWidgetOpt & opt,
  * @example	Tree3.rb
  * @example	Tree-icons.rb
  * @example	Tree-replace-items.rb
+ * @example	Tree-lazy-children.rb
  * @example	Wizard4.rb
  *
  *
@@ -2416,6 +2552,18 @@ YCPDialogParser::parseComboBox( YWidget * parent, YWidgetOpt & opt,
  * always sorted by insertion order. The application needs to handle sorting
  * itself, if desired.
  *
+ * Instead of a subitem list, an item may have the symbol <tt>`lazy</tt>:
+ * Its subitems are supplied only when the user opens that item. This is
+ * reported with an event (from <tt>UI::WaitForEvent()</tt>) with
+ * <tt>"EventReason"</tt> <tt>"Expanded"</tt> and the item ID as
+ * <tt>"ItemID"</tt>; the application then supplies the subitems with
+ * <tt>UI::ChangeWidget( `id(`tree), `Children( itemId ), [ `item(...), ... ] )</tt>.
+ * Use this for trees that are too large to build completely, like file
+ * system trees. <tt>UI::UserInput()</tt>, <tt>UI::TimeoutUserInput()</tt>
+ * and <tt>UI::PollInput()</tt> never return this event; an item opened
+ * while one of them was waiting is reported by the next
+ * <tt>UI::WaitForEvent()</tt>.
+ *
  * Note: The Qt version of the Wizard widget also provides a built-in tree with
  * an API that is (sometimes) easier to use.
  **/
@@ -2453,6 +2601,7 @@ YCPDialogParser::parseTree( YWidget * parent, YWidgetOpt & opt,
     {
 	YCPList itemList = term->value( argnr+1 )->asList();
 	tree->addItems( YCPTreeItemParser::parseTreeItemList( itemList ) );
+	YCPLazyTreeItems::invalidate( tree );
 
 	if ( tree->hasItems() && !multiSelection )
 	    tree->selectItem( tree->firstItem() );
@@ -2477,6 +2626,7 @@ YCPDialogParser::parseTree( YWidget * parent, YWidgetOpt & opt,
  * @option	immediate make :notify trigger immediately when the selected item changes
  * @option	keepSorting keep the insertion order - don't let the user sort manually by clicking
  * @option	multiSelection	user can select multiple items (rows) at once (shift-click, ctrl-click)
+ * @option	lazyItems add very long item lists chunk by chunk while waiting for user input
  * @example	Table1.rb
  * @example	Table2.rb
  * @example	Table3.rb
@@ -2556,6 +2706,17 @@ YCPDialogParser::parseTree( YWidget * parent, YWidgetOpt & opt,
  *
  * In this example, "Bluebird" has an additional icon in his "Role" column, and
  * "Wannabe" and "Coxxan" both have additional icons in their "Age" columns.
+ *
+ * With Opt(:lazyItems), only the first chunk of a very long item list is
+ * added when the table is created; the rest is added while the UI waits
+ * for user input. This makes dialogs with tens of thousands of items appear
+ * much faster. Before a property that reads or addresses items (like Items,
+ * Item, Cell, SelectedItems or setting CurrentItem) is changed or queried,
+ * all items are added, so this is transparent to the application. Setting
+ * Items replaces the remaining items without adding them first. Syntax
+ * errors in the first chunk and entries that are not <tt>`item()</tt> terms
+ * at all are reported right away; an item with other syntax errors is
+ * skipped, and the next property access that needs all items fails.
  **/
 
 YWidget *
@@ -2578,12 +2739,14 @@ YCPDialogParser::parseTable( YWidget * parent, YWidgetOpt & opt,
     bool immediate	= false;
     bool keepSorting	= false;
     bool multiSelection	= false;
+    bool lazyItems	= false;
 
     for ( int o=0; o < optList->size(); o++ )
     {
 	if	( optList->value(o)->isSymbol() && optList->value(o)->asSymbol()->symbol() == YUIOpt_immediate	    ) immediate	     = true;
 	else if ( optList->value(o)->isSymbol() && optList->value(o)->asSymbol()->symbol() == YUIOpt_keepSorting    ) keepSorting    = true;
 	else if ( optList->value(o)->isSymbol() && optList->value(o)->asSymbol()->symbol() == YUIOpt_multiSelection ) multiSelection = true;
+	else if ( optList->value(o)->isSymbol() && optList->value(o)->asSymbol()->symbol() == YCPOpt_lazyItems	    ) lazyItems	     = true;
 	else logUnknownOption( term, optList->value(o) );
     }
 
@@ -2598,7 +2761,16 @@ YCPDialogParser::parseTable( YWidget * parent, YWidgetOpt & opt,
 	table->setImmediateMode( true );
 
 
-    if ( numArgs >= 2 ) // Fill table with items, if item list is specified
+    if ( lazyItems )
+    {
+	YCPList itemList;
+
+	if ( numArgs >= 2 )
+	    itemList = term->value( argnr+1 )->asList();
+
+	YCPLazyTableItems::setItems( table, itemList );
+    }
+    else if ( numArgs >= 2 ) // Fill table with items, if item list is specified
     {
 	YCPList itemList = term->value( argnr+1 )->asList();
 	table->addItems( YCPTableItemParser::parseTableItemList( itemList ) );
@@ -3732,6 +3904,9 @@ YCPDialogParser::parseWizard( YWidget * parent, YWidgetOpt & opt,
     if ( wizard->nextButton()  )		wizard->nextButton()->setId ( nextButtonId  );
     wizard->contentsReplacePoint()->setId( contentsId );
 
+    // Those IDs were not set by parseWidgetTreeTerm(), so it can't add them
+    YCPWidgetIdIndex::addSubtree( wizard->findDialog(), wizard );
+
     return wizard;
 }
 
@@ -3888,9 +4063,25 @@ YCPDialogParser::findWidgetWithId( YWidget * widgetRoot, const YCPValue & idVal,
 {
     YUI_CHECK_PTR( widgetRoot );
 
+    YDialog * dialog = dynamic_cast<YDialog *>( widgetRoot );
+
+    if ( dialog )
+    {
+	YWidget * widget = YCPWidgetIdIndex::findWidget( dialog, idVal );
+
+	if ( widget )
+	    return widget;
+    }
+
+    // Not in the index (or not searching a complete dialog):
+    // Fall back to searching the widget tree.
+
     YCPValueWidgetID id( idVal );
     YWidget * widget = widgetRoot->findWidget( &id, doThrow );
 
+    if ( widget && dialog )
+	YCPWidgetIdIndex::addWidget( dialog, widget );
+
     return widget;
 }
 
@@ -3953,8 +4144,11 @@ YCPDialogParser::getWidgetId( const YCPTerm & term, int *argnr )
 
 	YCPValue id = idterm->value(0);
 
-	if ( findWidgetWithId( id,
-			       false ) ) // Don't throw exception if not found
+	// Only check the ID index here, not the complete widget tree: This is
+	// called for each new widget with an ID, and each tree walk would
+	// make parsing a dialog with many IDs quadratic.
+
+	if ( YCPWidgetIdIndex::findWidget( YDialog::currentDialog( false ), id ) )
 	{
 	    // Already have a widget with that ID?
 	    ycperror( "Widget id %s is not unique", id->toString().c_str() );
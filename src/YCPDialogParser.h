@@ -30,6 +30,8 @@ you may find current contact information at www.novell.com
 #define YCPDialogParser_h
 
 #include <vector>
+#include <string>
+#include <unordered_map>
 #include <ycp/YCPTerm.h>
 #include <ycp/YCPList.h>
 
@@ -37,6 +39,7 @@ you may find current contact information at www.novell.com
 #include <yui/YItemCustomStatus.h>
 
 using std::vector;
+using std::string;
 
 class YWidget;
 class YMenu;
@@ -110,6 +113,40 @@ public:
 
 protected:
 
+    /**
+     * Uniform signature of the entries in the widget type dispatch table.
+     * Any additional arguments of the individual parse...() functions
+     * (dimension, alignment, stretchability etc.) are bound in the table.
+     **/
+    typedef YWidget * (*WidgetParser)( YWidget *	parent,
+				       YWidgetOpt &	opt,
+				       const YCPTerm &	term,
+				       const YCPList &	optList,
+				       int		argnr );
+
+    typedef std::unordered_map<string, WidgetParser> WidgetParserMap;
+
+    /**
+     * Return the parser for widget type 'widgetName' (one of the
+     * YUIWidget_... or YUISpecialWidget_... names) or 0 if there is none.
+     **/
+    static WidgetParser widgetParser( const string & widgetName );
+
+    /**
+     * Create the widget type dispatch table. This is done only once; use
+     * widgetParser() to access it.
+     **/
+    static WidgetParserMap createWidgetParserMap();
+
+    /**
+     * Apply generic widget option 'optName' (notify, disabled, hstretch,
+     * key_F1 .. key_F24 etc.) to 'opt'.
+     *
+     * Return 'true' if this is a generic option, 'false' if not; in that
+     * case it is left to the widget specific parse...() function.
+     **/
+    static bool applyGenericOption( YWidgetOpt & opt, const char * optName );
+
     static YWidget * parseReplacePoint( YWidget *parent, YWidgetOpt & opt,
 					const YCPTerm & term, const YCPList & optList, int argnr );
 
@@ -36,6 +36,8 @@ you may find current contact information at www.novell.com
 #include <yui/YWidget.h>
 #include "YCPItem.h"
 #include "YCPMenuItem.h"
+#include "YCPLazyTreeItems.h"
+#include "YCPTreeItem.h"
 #include "YCPValueWidgetID.h"
 
 #define YUILogComponent "ui"
@@ -163,7 +165,19 @@ YCPEvent::addWidgetEventFields( YCPMap & map, const YCPValue & id ) const
     if ( ! widgetEvent )
 	return;
 
-    map->add( YCPString( "EventReason" ), YCPString ( YEvent::toString( widgetEvent->reason() )	) );
+    const YCPLazyTreeItemEvent * lazyTreeItemEvent = dynamic_cast<const YCPLazyTreeItemEvent *> (_event);
+
+    if ( lazyTreeItemEvent )
+    {
+	// There is no such reason in YEvent::EventReason
+
+	map->add( YCPString( "EventReason" ), YCPString( "Expanded" ) );
+	map->add( YCPString( "ItemID" ), lazyTreeItemEvent->item()->id() );
+    }
+    else
+    {
+	map->add( YCPString( "EventReason" ), YCPString ( YEvent::toString( widgetEvent->reason() )	) );
+    }
 
     YWidget * widget = widgetEvent->widget();
 
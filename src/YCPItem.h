@@ -32,6 +32,8 @@ you may find current contact information at www.novell.com
 #include <ycp/YCPValue.h>
 #include <ycp/YCPString.h>
 #include <yui/YDescribedItem.h>
+#include "YCPItemPool.h"
+#include "YCP_util.h"
 
 
 /**
@@ -47,6 +49,8 @@ public:
     YCPItem( const YCPString &	label )
 	: YDescribedItem( label->value() )
 	, _id( label )
+	, _label( label )
+	, _description( YCPNull() )
 	{}
 
     YCPItem( const YCPValue  & 	id,
@@ -59,6 +63,8 @@ public:
                           iconName->value(),
                           selected )
 	, _id( id )
+	, _label( label )
+	, _description( description )
 	{}
 
     /**
@@ -67,6 +73,11 @@ public:
     virtual ~YCPItem()
 	{}
 
+    /**
+     * Allocate items from a pool: There are often very many of them.
+     **/
+    YCP_ITEM_POOL( YCPItem )
+
     /**
      * Return 'true' if this item has an ID.
      **/
@@ -83,26 +94,30 @@ public:
     void setId( const YCPValue & newId ) { _id = newId; }
 
     /**
-     * Return this item's label as a YCPString.
+     * Return this item's label as a YCPString: The original one this item
+     * was created with (so it is shared, not copied) unless the label was
+     * changed behind its back in the meantime. See cachedYCPString().
      **/
-    YCPString label() const { return YCPString( YDescribedItem::label() ); }
+    YCPString label() const
+	{ return cachedYCPString( _label, YDescribedItem::label() ); }
 
     /**
      * Set this item's label with a YCPString.
      **/
     void setLabel( const YCPString & newLabel )
-	{ YItem::setLabel( newLabel->value() ); }
+	{ YItem::setLabel( newLabel->value() ); _label = newLabel; }
 
     /**
-     * Return this item's description as a YCPString.
+     * Return this item's description as a YCPString. See also label().
      **/
-    YCPString description() const { return YCPString( YDescribedItem::description() ); }
+    YCPString description() const
+	{ return cachedYCPString( _description, YDescribedItem::description() ); }
 
     /**
      * Set this item's description with a YCPString.
      **/
     void setDescription( const YCPString & newDescription )
-        { YDescribedItem::setDescription( newDescription->value() ); }
+        { YDescribedItem::setDescription( newDescription->value() ); _description = newDescription; }
 
     /**
      * Return this item's icon name as a YCPString.
@@ -117,7 +132,10 @@ public:
 
 
 private:
-    YCPValue _id;
+
+    YCPValue		_id;
+    mutable YCPString	_label;
+    mutable YCPString	_description;
 };
 
 
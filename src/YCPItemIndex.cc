@@ -0,0 +1,217 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPItemIndex.cc
+
+		Per-widget index of item IDs for fast item lookup.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#define YUILogComponent "ui"
+#include <yui/YUILog.h>
+
+#include <yui/YSelectionWidget.h>
+#include <yui/YDialog.h>
+
+#include "YCPItemIndex.h"
+#include "YCPItem.h"
+#include "YCPMenuItem.h"
+#include "YCPTableItem.h"
+#include "YCPTreeItem.h"
+#include "YCPValueWidgetID.h"
+
+
+YCPItemIndex::WidgetMap YCPItemIndex::_widgets;
+
+
+YItem *
+YCPItemIndex::findItem( YSelectionWidget * widget, const YCPValue & id )
+{
+    if ( ! widget || id.isNull() )
+	return 0;
+
+    Index & idx = index( widget );
+    IdMap::const_iterator it = idx.items.find( YCPValueWidgetID::hashValue( id ) );
+
+    if ( it == idx.items.end() )
+	return 0;
+
+    // Same hash doesn't necessarily mean same ID (`foo vs. "foo", collisions)
+
+    const vector<YItem *> & candidates = it->second;
+
+    for ( size_t i=0; i < candidates.size(); i++ )
+    {
+	if ( id->equal( itemId( candidates[i] ) ) )
+	    return candidates[i];
+    }
+
+    return 0;
+}
+
+
+void
+YCPItemIndex::invalidate( YSelectionWidget * widget )
+{
+    _widgets.erase( widget );
+}
+
+
+void
+YCPItemIndex::removeChildren( YWidget * widget )
+{
+    if ( ! widget || _widgets.empty() )
+	return;
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	removeRecursive( *it );
+    }
+}
+
+
+void
+YCPItemIndex::removeDialog( YDialog * dialog )
+{
+    WidgetMap::iterator it = _widgets.begin();
+
+    while ( it != _widgets.end() )
+    {
+	if ( it->second.dialog == dialog )
+	    it = _widgets.erase( it );
+	else
+	    ++it;
+    }
+}
+
+
+YCPValue
+YCPItemIndex::itemId( const YItem * item )
+{
+    const YCPItem * ycpItem = dynamic_cast<const YCPItem *>( item );
+
+    if ( ycpItem )
+	return ycpItem->hasId() ? ycpItem->id() : YCPNull();
+
+    const YCPTableItem * tableItem = dynamic_cast<const YCPTableItem *>( item );
+
+    if ( tableItem )
+	return tableItem->hasId() ? tableItem->id() : YCPNull();
+
+    const YCPTreeItem * treeItem = dynamic_cast<const YCPTreeItem *>( item );
+
+    if ( treeItem )
+	return treeItem->hasId() ? treeItem->id() : YCPNull();
+
+    const YCPMenuItem * menuItem = dynamic_cast<const YCPMenuItem *>( item );
+
+    if ( menuItem )
+	return menuItem->hasId() ? menuItem->id() : YCPNull();
+
+    return YCPNull();
+}
+
+
+YCPItemIndex::Index &
+YCPItemIndex::index( YSelectionWidget * widget )
+{
+    YItem * firstItem = widget->hasItems() ? *( widget->itemsBegin() ) : 0;
+    WidgetMap::iterator it = _widgets.find( widget );
+
+    if ( it != _widgets.end() &&
+	 it->second.itemsCount == widget->itemsCount() &&
+	 it->second.firstItem  == firstItem )
+    {
+	return it->second;
+    }
+
+    Index & idx = _widgets[ widget ];
+
+    idx.dialog		= widget->findDialog();
+    idx.itemsCount	= widget->itemsCount();
+    idx.firstItem	= firstItem;
+    idx.items.clear();
+
+    addItems( idx, widget );
+
+    yuiDebug() << "Created item ID index for " << widget
+	       << " with " << idx.items.size() << " IDs" << endl;
+
+    return idx;
+}
+
+
+void
+YCPItemIndex::addItems( Index & idx, YSelectionWidget * widget )
+{
+    // Iterative depth-first traversal: Trees may be deep, and the order
+    // must be the same as that of a recursive search so the first match
+    // wins for duplicate IDs.
+
+    typedef std::pair<YItemConstIterator, YItemConstIterator> Range;
+    vector<Range> stack;
+
+    stack.push_back( Range( widget->itemsBegin(), widget->itemsEnd() ) );
+
+    while ( ! stack.empty() )
+    {
+	Range & range = stack.back();
+
+	if ( range.first == range.second )
+	{
+	    stack.pop_back();
+	    continue;
+	}
+
+	YItem * item = *( range.first );
+	++range.first;
+
+	YCPValue id = itemId( item );
+
+	if ( ! id.isNull() )
+	    idx.items[ YCPValueWidgetID::hashValue( id ) ].push_back( item );
+
+	if ( item->hasChildren() )
+	    stack.push_back( Range( item->childrenBegin(), item->childrenEnd() ) );
+    }
+}
+
+
+void
+YCPItemIndex::removeRecursive( YWidget * widget )
+{
+    YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
+
+    if ( selWidget )
+	_widgets.erase( selWidget );
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	removeRecursive( *it );
+    }
+}
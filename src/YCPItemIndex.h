@@ -0,0 +1,139 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPItemIndex.h
+
+		Per-widget index of item IDs for fast item lookup.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPItemIndex_h
+#define YCPItemIndex_h
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include <ycp/YCPValue.h>
+
+using std::vector;
+
+class YItem;
+class YWidget;
+class YDialog;
+class YSelectionWidget;
+
+
+/**
+ * Index from item IDs to items, one for each selection widget (SelectionBox,
+ * Table, Tree, ComboBox, MenuButton etc.).
+ *
+ * Without this, finding an item by its ID means a linear (and for trees,
+ * recursive) search through all items; setting a property that refers to K
+ * items of a widget with N items would cost O(K*N).
+ *
+ * The index of a widget is created lazily by walking all its items when it
+ * is first needed. It is invalidated when the items of that widget are
+ * replaced (invalidate()), and it is deleted when the widget is deleted
+ * (removeChildren(), removeDialog()). As an additional safeguard, it is
+ * also rebuilt when the number of toplevel items or the first toplevel item
+ * changes.
+ **/
+class YCPItemIndex
+{
+public:
+
+    /**
+     * Find the item with ID 'id' in 'widget', including all tree item
+     * children. If there are several, return the first one in depth-first
+     * order, just like a recursive search would.
+     *
+     * Return 0 if there is no such item.
+     **/
+    static YItem * findItem( YSelectionWidget * widget, const YCPValue & id );
+
+    /**
+     * Invalidate the index of 'widget'. Call this after changing its items
+     * other than by just changing their status.
+     **/
+    static void invalidate( YSelectionWidget * widget );
+
+    /**
+     * Delete the indexes of all descendants of 'widget' (but not of 'widget'
+     * itself). Call this before deleting the children of a widget.
+     **/
+    static void removeChildren( YWidget * widget );
+
+    /**
+     * Delete the indexes of all widgets of 'dialog'. Call this when a dialog
+     * is closed or when a new dialog is created.
+     **/
+    static void removeDialog( YDialog * dialog );
+
+    /**
+     * Return the ID of an item if it is one of the YCP...Item classes or
+     * YCPNull if it is not.
+     **/
+    static YCPValue itemId( const YItem * item );
+
+protected:
+
+    typedef std::unordered_map<uint64_t, vector<YItem *> > IdMap;
+
+    struct Index
+    {
+	YDialog *	dialog;
+	int		itemsCount;
+	YItem *		firstItem;
+	IdMap		items;
+    };
+
+    typedef std::unordered_map<const YSelectionWidget *, Index> WidgetMap;
+
+    /**
+     * Return the index of 'widget'. Create or rebuild it if necessary.
+     **/
+    static Index & index( YSelectionWidget * widget );
+
+    /**
+     * Add all items of 'widget' to 'index' in depth-first order.
+     **/
+    static void addItems( Index & index, YSelectionWidget * widget );
+
+    /**
+     * Delete the index of 'widget' and of all its descendants.
+     **/
+    static void removeRecursive( YWidget * widget );
+
+private:
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPItemIndex() {}
+
+    static WidgetMap _widgets;
+};
+
+
+#endif // YCPItemIndex_h
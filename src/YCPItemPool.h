@@ -0,0 +1,147 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPItemPool.h
+
+		Pool allocator for item and table cell objects.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPItemPool_h
+#define YCPItemPool_h
+
+#include <stddef.h>
+#include <new>
+
+
+/**
+ * Pool allocator for objects of class T: Item classes like YCPItem or
+ * YCPTableItem use this in their operator new / operator delete.
+ *
+ * Item lists are often very long (tens of thousands of table items, each
+ * with several cells), so allocating them one by one with the global
+ * operator new is expensive, and the objects end up scattered all over the
+ * heap. This allocates them in slabs of many objects each and keeps freed
+ * objects on a free list for reuse, so allocating and freeing an object is
+ * just a pointer operation, and the objects of one item list are close
+ * together in memory.
+ *
+ * The slabs are never returned to the system; memory of freed objects is
+ * reused for the next items. Objects of derived classes with a different
+ * size are allocated with the global operator new.
+ *
+ * This is not thread-safe: Items are only created and deleted in the UI
+ * thread.
+ **/
+template<class T>
+class YCPItemPool
+{
+public:
+
+    /**
+     * Allocate memory for one object of 'size' bytes.
+     **/
+    static void * allocate( size_t size )
+    {
+	if ( size != sizeof( T ) )
+	    return ::operator new( size );
+
+	if ( ! _freeList )
+	    addSlab();
+
+	Block * block = _freeList;
+	_freeList = block->next;
+
+	return block;
+    }
+
+    /**
+     * Free memory that was allocated with allocate() with the same 'size'.
+     **/
+    static void deallocate( void * ptr, size_t size )
+    {
+	if ( ! ptr )
+	    return;
+
+	if ( size != sizeof( T ) )
+	{
+	    ::operator delete( ptr );
+	    return;
+	}
+
+	Block * block = static_cast<Block *>( ptr );
+	block->next   = _freeList;
+	_freeList     = block;
+    }
+
+private:
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPItemPool() {}
+
+    union Block
+    {
+	Block *	next;
+	alignas( T ) char storage[ sizeof( T ) ];
+    };
+
+    enum { SlabSize = 1024 };	// objects per slab
+
+    /**
+     * Allocate a new slab and put all its blocks on the free list.
+     **/
+    static void addSlab()
+    {
+	Block * slab = static_cast<Block *>( ::operator new( SlabSize * sizeof( Block ) ) );
+
+	for ( int i = SlabSize - 1; i >= 0; i-- )
+	{
+	    slab[i].next = _freeList;
+	    _freeList	 = &slab[i];
+	}
+    }
+
+    static Block * _freeList;
+};
+
+
+template<class T>
+typename YCPItemPool<T>::Block * YCPItemPool<T>::_freeList = 0;
+
+
+/**
+ * Declare operator new and operator delete for class 'CLASS' to use
+ * YCPItemPool<CLASS>. Use this in the public section of the class
+ * declaration.
+ **/
+#define YCP_ITEM_POOL( CLASS )							\
+    static void * operator new( size_t size )					\
+	{ return YCPItemPool<CLASS>::allocate( size ); }			\
+    static void operator delete( void * ptr, size_t size )			\
+	{ YCPItemPool<CLASS>::deallocate( ptr, size ); }
+
+
+#endif // YCPItemPool_h
@@ -95,19 +95,28 @@ YCPItemWriter::itemTerm( const YItem * item, bool withDescription )
 	itemTerm->add( iconTerm );
     }
 
-    itemTerm->add( YCPString( item->label() ) );        // label
+    if ( ycpItem )					// label
+	itemTerm->add( ycpItem->label() );		// (shared with the item, not copied)
+    else
+	itemTerm->add( YCPString( item->label() ) );
 
     if ( withDescription )
     {
-        string description;
+        if ( ycpItem )
+        {
+            itemTerm->add( ycpItem->description() );	// description
+        }
+        else
+        {
+            string description;
 
-        const YDescribedItem * describedItem = dynamic_cast<const YDescribedItem *>( item );
+            const YDescribedItem * describedItem = dynamic_cast<const YDescribedItem *>( item );
 
-        if ( describedItem )
-            description = describedItem->description();
-
-        itemTerm->add( YCPString( description ) );      // description
+            if ( describedItem )
+                description = describedItem->description();
 
+            itemTerm->add( YCPString( description ) );
+        }
     }
 
     if ( item->selected() )                             // isSelected
@@ -0,0 +1,205 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPItemsCache.cc
+
+		Cache for the Items property of selection widgets.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#include <vector>
+
+#define YUILogComponent "ui"
+#include <yui/YUILog.h>
+
+#include <yui/YSelectionWidget.h>
+#include <yui/YMenuWidget.h>
+#include <yui/YTable.h>
+#include <yui/YTree.h>
+#include <yui/YDialog.h>
+
+#include "YCPItemsCache.h"
+
+
+YCPItemsCache::WidgetMap YCPItemsCache::_widgets;
+
+
+YCPValue
+YCPItemsCache::lookup( YSelectionWidget * widget )
+{
+    if ( _widgets.empty() )
+	return YCPNull();
+
+    WidgetMap::const_iterator it = _widgets.find( widget );
+
+    if ( it == _widgets.end() )
+	return YCPNull();
+
+    const Entry & entry = it->second;
+    YItem * firstItem	= widget->hasItems() ? *( widget->itemsBegin() ) : 0;
+
+    if ( entry.itemsCount != widget->itemsCount() ||
+	 entry.firstItem  != firstItem		  ||
+	 ( entry.stateFlags != NoState &&
+	   entry.state	    != state( widget, entry.stateFlags ) ) )
+    {
+	return YCPNull();
+    }
+
+    return entry.items;
+}
+
+
+void
+YCPItemsCache::store( YSelectionWidget * widget, const YCPValue & items )
+{
+    Entry & entry = _widgets[ widget ];
+
+    entry.dialog	= widget->findDialog();
+    entry.itemsCount	= widget->itemsCount();
+    entry.firstItem	= widget->hasItems() ? *( widget->itemsBegin() ) : 0;
+    entry.stateFlags	= stateFlags( widget );
+    entry.state		= entry.stateFlags != NoState ? state( widget, entry.stateFlags ) : 0;
+    entry.items		= items;
+}
+
+
+void
+YCPItemsCache::invalidate( YSelectionWidget * widget )
+{
+    _widgets.erase( widget );
+}
+
+
+void
+YCPItemsCache::removeChildren( YWidget * widget )
+{
+    if ( ! widget || _widgets.empty() )
+	return;
+
+    WidgetMap::iterator it = _widgets.begin();
+
+    while ( it != _widgets.end() )
+    {
+	// Is 'widget' an ancestor of this one?
+
+	YWidget * parent = it->first->parent();
+
+	while ( parent && parent != widget )
+	    parent = parent->parent();
+
+	if ( parent )
+	    it = _widgets.erase( it );
+	else
+	    ++it;
+    }
+}
+
+
+void
+YCPItemsCache::removeDialog( YDialog * dialog )
+{
+    WidgetMap::iterator it = _widgets.begin();
+
+    while ( it != _widgets.end() )
+    {
+	if ( it->second.dialog == dialog )
+	    it = _widgets.erase( it );
+	else
+	    ++it;
+    }
+}
+
+
+int
+YCPItemsCache::stateFlags( YSelectionWidget * widget )
+{
+    // See the item writers for what they return
+
+    if ( dynamic_cast<YMenuWidget *>( widget ) )
+	return NoState;
+
+    if ( dynamic_cast<YTree *>( widget ) )
+	return OpenState;
+
+    if ( dynamic_cast<YTable *>( widget ) )
+    {
+	// Only nested tables have open / closed items
+
+	for ( YItemConstIterator it = widget->itemsBegin(); it != widget->itemsEnd(); ++it )
+	{
+	    if ( (*it)->hasChildren() )
+		return OpenState;
+	}
+
+	return NoState;
+    }
+
+    return SelectedState;
+}
+
+
+uint64_t
+YCPItemsCache::state( YSelectionWidget * widget, int stateFlags )
+{
+    typedef std::pair<YItemConstIterator, YItemConstIterator> Range;
+    std::vector<Range> stack;
+    uint64_t hash = 14695981039346656037ULL;
+
+    stack.push_back( Range( widget->itemsBegin(), widget->itemsEnd() ) );
+
+    while ( ! stack.empty() )
+    {
+	Range & range = stack.back();
+
+	if ( range.first == range.second )
+	{
+	    stack.pop_back();
+	    continue;
+	}
+
+	const YItem * item = *( range.first );
+	++range.first;
+
+	int bits = 0;
+
+	if ( ( stateFlags & SelectedState ) && item->selected() )
+	    bits |= 1;
+
+	if ( ( stateFlags & OpenState ) && item->hasChildren() )
+	{
+	    if ( item->isOpen() )
+		bits |= 2;
+
+	    stack.push_back( Range( item->childrenBegin(), item->childrenEnd() ) );
+	}
+
+	// FNV-1a style: Each item changes the hash, so the position of a
+	// selected or open item matters, not only how many there are.
+
+	hash = ( hash ^ bits ) * 1099511628211ULL;
+    }
+
+    return hash;
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPItemsCache.h
+
+		Cache for the Items property of selection widgets.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPItemsCache_h
+#define YCPItemsCache_h
+
+#include <stdint.h>
+#include <unordered_map>
+#include <ycp/YCPValue.h>
+
+class YItem;
+class YWidget;
+class YDialog;
+class YSelectionWidget;
+
+
+/**
+ * Cache for the result of QueryWidget( `id(...), `Items ): The YCP item list
+ * of each selection widget that was last returned.
+ *
+ * Creating that list means creating several YCP values for each item, so
+ * for a widget with many items that is expensive. Applications often query
+ * the same unchanged list several times.
+ *
+ * The cache entry of a widget has to be invalidated (invalidate()) by
+ * everything that changes its items other than by user interaction: Setting
+ * new items, changing table cells etc. What the user can change (selected
+ * items, open tree branches) is part of the item list for some widget
+ * types; for those, a fingerprint of that state is checked upon each
+ * lookup. This needs a walk over all items, but no allocations. For flat
+ * tables and for menus, a lookup is O(1).
+ **/
+class YCPItemsCache
+{
+public:
+
+    /**
+     * Return the cached item list of 'widget' or YCPNull if there is none
+     * or if it is outdated.
+     **/
+    static YCPValue lookup( YSelectionWidget * widget );
+
+    /**
+     * Store 'items' as the current item list of 'widget'.
+     **/
+    static void store( YSelectionWidget * widget, const YCPValue & items );
+
+    /**
+     * Invalidate the cached item list of 'widget'. Call this after any
+     * change of its items.
+     **/
+    static void invalidate( YSelectionWidget * widget );
+
+    /**
+     * Delete the entries of all descendants of 'widget' (but not of 'widget'
+     * itself). Call this before deleting the children of a widget.
+     **/
+    static void removeChildren( YWidget * widget );
+
+    /**
+     * Delete the entries of all widgets of 'dialog'. Call this when a dialog
+     * is closed or when a new dialog is created.
+     **/
+    static void removeDialog( YDialog * dialog );
+
+protected:
+
+    /**
+     * Which user-changeable state is part of the item list of a widget
+     **/
+    enum StateFlags
+    {
+	NoState		= 0,
+	SelectedState	= 1,	// `item(..., true) for selected items
+	OpenState	= 2	// `open / `closed or true for open tree branches
+    };
+
+    struct Entry
+    {
+	YDialog *	dialog;
+	int		itemsCount;
+	YItem *		firstItem;
+	int		stateFlags;
+	uint64_t	state;
+	YCPValue	items;
+    };
+
+    typedef std::unordered_map<const YSelectionWidget *, Entry> WidgetMap;
+
+    /**
+     * Return the StateFlags for the item list of 'widget'.
+     **/
+    static int stateFlags( YSelectionWidget * widget );
+
+    /**
+     * Return a fingerprint of the user-changeable state in 'stateFlags' of
+     * all items of 'widget'.
+     **/
+    static uint64_t state( YSelectionWidget * widget, int stateFlags );
+
+private:
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPItemsCache() {}
+
+    static WidgetMap _widgets;
+};
+
+
+#endif // YCPItemsCache_h
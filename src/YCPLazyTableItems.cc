@@ -0,0 +1,285 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPLazyTableItems.cc
+
+		Tables that add their items chunk by chunk.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#define YUILogComponent "ui"
+#include <yui/YUILog.h>
+
+#include <yui/YTable.h>
+#include <yui/YProperty.h>
+#include <yui/YDialog.h>
+#include <yui/YUIException.h>
+#include <yui/YUISymbols.h>
+
+#include "YCPLazyTableItems.h"
+#include "YCPItemIndex.h"
+#include "YCPItemsCache.h"
+#include "YCPPropertyHandler.h"
+#include "YCPTableItemParser.h"
+#include "YCP_UI_Exception.h"
+
+// Number of items to parse and add at once
+#define CHUNK_SIZE	1000
+
+
+YCPLazyTableItems::TableMap YCPLazyTableItems::_tables;
+
+
+void
+YCPLazyTableItems::setItems( YTable * table, const YCPList & itemList )
+{
+    int end = itemList->size() < CHUNK_SIZE ? itemList->size() : CHUNK_SIZE;
+
+    // Check at least the shape of the remaining items now while there is
+    // still a caller to report errors to; this doesn't create anything.
+
+    for ( int i=end; i < itemList->size(); i++ )
+    {
+	YCPValue itemTerm = itemList->value(i);
+
+	if ( ! itemTerm->isTerm() || itemTerm->asTerm()->name() != YUISymbol_item )
+	    YUI_THROW( YCPDialogSyntaxErrorException( "Expected `item(...)", itemTerm ) );
+    }
+
+    table->setItems( YCPTableItemParser::parseTableItemList( itemList, 0, end ) );
+    YCPItemIndex::invalidate( table );
+    YCPItemsCache::invalidate( table );
+
+    Pending & pending = _tables[ table ];
+
+    pending.dialog	= table->findDialog();
+    pending.items	= itemList;
+    pending.next	= end;
+
+    yuiDebug() << "Added " << end << " of " << itemList->size()
+	       << " items to " << table << endl;
+}
+
+
+bool
+YCPLazyTableItems::isLazy( const YTable * table )
+{
+    return _tables.find( const_cast<YTable *>( table ) ) != _tables.end();
+}
+
+
+void
+YCPLazyTableItems::materialize( YWidget * widget )
+{
+    if ( _tables.empty() )
+	return;
+
+    TableMap::iterator it = _tables.find( dynamic_cast<YTable *>( widget ) );
+
+    if ( it != _tables.end() && it->second.next < it->second.items->size() )
+	addItems( it->first, it->second, it->second.items->size(), true );
+}
+
+
+void
+YCPLazyTableItems::prepareProperty( YWidget *		widget,
+				     const YCPValue &	property,
+				     bool		change )
+{
+    if ( _tables.empty() )
+	return;
+
+    // Terms like `Item(id) or `Cell(id, column) always address an item
+
+    if ( property->isSymbol() &&
+	 ! needsAllItems( property->asSymbol()->symbol(), change ) )
+    {
+	return;
+    }
+
+    materialize( widget );
+}
+
+
+bool
+YCPLazyTableItems::needsAllItems( const string & propertyName, bool change )
+{
+    if ( propertyName == YUIProperty_Items )
+	return ! change;	// Setting Items replaces the remaining items
+
+    if ( propertyName == YUIProperty_Value ||
+	 propertyName == YUIProperty_CurrentItem )
+    {
+	// Setting them addresses an item by ID; the current item
+	// can only be one that was already added.
+
+	return change;
+    }
+
+    return propertyName == YUIProperty_SelectedItems ||
+	propertyName == YUIProperty_ItemStatus	    ||
+	propertyName == YCPProperty_ItemsDiff	    ||
+	propertyName == YCPProperty_ItemIds	    ||
+	propertyName == YCPProperty_Cells;
+}
+
+
+bool
+YCPLazyTableItems::materializeChunk( YDialog * dialog )
+{
+    bool morePending = false;
+    bool added	     = false;
+
+    for ( TableMap::iterator it = _tables.begin(); it != _tables.end(); ++it )
+    {
+	Pending & pending = it->second;
+
+	if ( pending.dialog != dialog || pending.next >= pending.items->size() )
+	    continue;
+
+	if ( ! added )
+	{
+	    addItems( it->first, pending, pending.next + CHUNK_SIZE, false );
+	    added = true;
+	}
+
+	if ( pending.next < pending.items->size() )
+	    morePending = true;
+    }
+
+    return morePending;
+}
+
+
+bool
+YCPLazyTableItems::hasPending( YDialog * dialog )
+{
+    for ( TableMap::const_iterator it = _tables.begin(); it != _tables.end(); ++it )
+    {
+	if ( it->second.dialog == dialog && it->second.next < it->second.items->size() )
+	    return true;
+    }
+
+    return false;
+}
+
+
+void
+YCPLazyTableItems::removeChildren( YWidget * widget )
+{
+    TableMap::iterator it = _tables.begin();
+
+    while ( it != _tables.end() )
+    {
+	// Is 'widget' an ancestor of this table?
+
+	YWidget * parent = it->first->parent();
+
+	while ( parent && parent != widget )
+	    parent = parent->parent();
+
+	if ( parent )
+	    it = _tables.erase( it );
+	else
+	    ++it;
+    }
+}
+
+
+void
+YCPLazyTableItems::removeDialog( YDialog * dialog )
+{
+    TableMap::iterator it = _tables.begin();
+
+    while ( it != _tables.end() )
+    {
+	if ( it->second.dialog == dialog )
+	    it = _tables.erase( it );
+	else
+	    ++it;
+    }
+}
+
+
+void
+YCPLazyTableItems::addItems( YTable * table, Pending & pending, int end, bool doThrow )
+{
+    int begin = pending.next;
+
+    if ( end > pending.items->size() )
+	end = pending.items->size();
+
+    // Move on even if there is a syntax error: Don't try it again and
+    // again with each user input.
+
+    pending.next = end;
+
+    YItemCollection items;
+    items.reserve( end - begin );
+    YCPValue badItem = YCPNull();
+
+    for ( int i=begin; i < end; i++ )
+    {
+	// Skip only the bad item, not the whole chunk
+
+	try
+	{
+	    YItemCollection item = YCPTableItemParser::parseTableItemList( pending.items, i, i+1 );
+	    items.insert( items.end(), item.begin(), item.end() );
+	}
+	catch ( YUIException & exception )
+	{
+	    YUI_CAUGHT( exception );
+	    yuiError() << "Skipping item #" << i << " of " << table << endl;
+
+	    if ( badItem.isNull() )
+		badItem = pending.items->value(i);
+	}
+    }
+
+    if ( ! items.empty() )
+    {
+	table->addItems( items );
+	YCPItemIndex::invalidate( table );
+	YCPItemsCache::invalidate( table );
+    }
+
+    if ( pending.next >= pending.items->size() )
+    {
+	// Don't keep the YCP items: The table has them all now
+	pending.items = YCPList();
+	pending.next  = 0;
+    }
+
+    // When the items are added chunk by chunk while waiting for user input,
+    // there is nobody to report this to: The dialog was already opened
+    // successfully. But a ChangeWidget() or QueryWidget() that needed all
+    // items should fail just like it would without lazy items.
+
+    if ( doThrow && ! badItem.isNull() )
+    {
+	YUI_THROW( YCPDialogSyntaxErrorException( "Expected `item(`id(...), \"label\", ...)",
+						  badItem ) );
+    }
+}
@@ -0,0 +1,158 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPLazyTableItems.h
+
+		Tables that add their items chunk by chunk.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPLazyTableItems_h
+#define YCPLazyTableItems_h
+
+#include <unordered_map>
+#include <string>
+#include <ycp/YCPList.h>
+
+using std::string;
+
+class YWidget;
+class YDialog;
+class YTable;
+
+
+/**
+ * Widget option for Table: Add the items chunk by chunk.
+ **/
+#define YCPOpt_lazyItems	"lazyItems"
+
+
+/**
+ * Support for tables with Opt(`lazyItems): Such a table keeps the YCP list
+ * of its items and creates only the first chunk of YCPTableItems right away,
+ * so the dialog can be shown very quickly even with a very large number of
+ * items. The remaining chunks are added while the UI waits for user input
+ * (see YCP_UI::doUserInput()).
+ *
+ * Before a property that reads or addresses items (Items, Item, Cell,
+ * SelectedItems etc.) is changed or queried, all remaining items of such a
+ * table are added, so those properties always see the complete list. Other
+ * properties like Enabled or Label don't need them.
+ **/
+class YCPLazyTableItems
+{
+public:
+
+    /**
+     * Register 'table' as a lazy table and set 'itemList' as its new items:
+     * Parse and add the first chunk now and keep the rest for later.
+     *
+     * This throws exceptions if there are syntax errors in the first chunk
+     * or if any of the remaining items is not an `item() term.
+     **/
+    static void setItems( YTable * table, const YCPList & itemList );
+
+    /**
+     * Return 'true' if 'table' was registered as a lazy table.
+     **/
+    static bool isLazy( const YTable * table );
+
+    /**
+     * Add all remaining items of 'widget' if it is a lazy table. Do nothing
+     * otherwise. Call this before accessing any property of a widget.
+     *
+     * Items with syntax errors are skipped; an exception for the first of
+     * them is thrown after all other items were added.
+     **/
+    static void materialize( YWidget * widget );
+
+    /**
+     * Prepare 'widget' for changing (if 'change' is 'true') or querying
+     * 'property' if it is a lazy table: Add all remaining items if that
+     * property reads or addresses items. Do nothing for other properties and
+     * for setting Items: That replaces the remaining items anyway.
+     **/
+    static void prepareProperty( YWidget *		widget,
+				 const YCPValue &	property,
+				 bool			change );
+
+    /**
+     * Add the next chunk of items to one of the lazy tables of 'dialog'.
+     * Return 'true' if there are any more items to add afterwards.
+     **/
+    static bool materializeChunk( YDialog * dialog );
+
+    /**
+     * Return 'true' if any lazy table of 'dialog' still has items to add.
+     **/
+    static bool hasPending( YDialog * dialog );
+
+    /**
+     * Forget all lazy tables that are descendants of 'widget' (but not
+     * 'widget' itself). Call this before deleting the children of a widget.
+     **/
+    static void removeChildren( YWidget * widget );
+
+    /**
+     * Forget all lazy tables of 'dialog'. Call this when a dialog is closed
+     * or when a new dialog is created.
+     **/
+    static void removeDialog( YDialog * dialog );
+
+protected:
+
+    /**
+     * Return 'true' if changing (if 'change' is 'true') or querying property
+     * 'propertyName' of a table needs all its items.
+     **/
+    static bool needsAllItems( const string & propertyName, bool change );
+
+    struct Pending
+    {
+	YDialog *	dialog;
+	YCPList		items;
+	int		next;	// index of the first item not added yet
+    };
+
+    typedef std::unordered_map<YTable *, Pending> TableMap;
+
+    /**
+     * Add the items of 'pending' up to (excluding) index 'end' to 'table'.
+     * Skip items with syntax errors. If 'doThrow' is true, throw an
+     * exception for the first of them afterwards.
+     **/
+    static void addItems( YTable * table, Pending & pending, int end, bool doThrow );
+
+private:
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPLazyTableItems() {}
+
+    static TableMap _tables;
+};
+
+
+#endif // YCPLazyTableItems_h
@@ -0,0 +1,270 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPLazyTreeItems.cc
+
+		Tree items whose children are supplied when the user opens them.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#define YUILogComponent "ui"
+#include <yui/YUILog.h>
+
+#include <yui/YTree.h>
+#include <yui/YDialog.h>
+#include <yui/YUIException.h>
+
+#include "YCPLazyTreeItems.h"
+#include "YCPItemIndex.h"
+#include "YCPItemsCache.h"
+#include "YCPTreeItem.h"
+#include "YCPTreeItemParser.h"
+
+// Label of the placeholder child of a lazy item
+#define PLACEHOLDER_LABEL	"..."
+
+
+YCPLazyTreeItems::TreeMap	YCPLazyTreeItems::_trees;
+YCPLazyTreeItemEvent *		YCPLazyTreeItems::_lastEvent = 0;
+
+
+YCPLazyTreeItemEvent::YCPLazyTreeItemEvent( YTree * tree, YCPTreeItem * item )
+    : YWidgetEvent( tree, YEvent::Activated )
+    , _item( item )
+{
+}
+
+
+void
+YCPLazyTreeItems::addPlaceholder( YCPTreeItem * item )
+{
+    item->setLazy( true );
+
+    // No ID: The placeholder is never returned to the application
+
+    YCPTreeItem * placeholder = new YCPTreeItem( item,
+						 YCPString( PLACEHOLDER_LABEL ),
+						 YCPNull(),
+						 false );
+    YUI_CHECK_NEW( placeholder );
+}
+
+
+void
+YCPLazyTreeItems::setChildren( YTree *		tree,
+			       YCPTreeItem *	item,
+			       const YCPList &	childList )
+{
+    item->deleteChildren();
+    item->setLazy( false );
+
+    try
+    {
+	for ( int i=0; i < childList->size(); i++ )
+	    YCPTreeItemParser::parseTreeItem( item, childList->value(i) );
+    }
+    catch ( YUIException & exception )
+    {
+	// Go back to a lazy item so the application can try again
+
+	item->deleteChildren();
+	addPlaceholder( item );
+	tree->rebuildTree();
+	throw;
+    }
+
+    YCPItemIndex::invalidate( tree );
+    YCPItemsCache::invalidate( tree );
+    invalidate( tree );
+
+    tree->rebuildTree();
+}
+
+
+void
+YCPLazyTreeItems::invalidate( YTree * tree )
+{
+    Entry & entry = _trees[ tree ];
+
+    entry.dialog = tree->findDialog();
+    entry.dirty	 = true;
+    entry.items.clear();
+}
+
+
+bool
+YCPLazyTreeItems::hasLazyItems( YDialog * dialog )
+{
+    TreeMap::iterator it = _trees.begin();
+
+    while ( it != _trees.end() )
+    {
+	Entry & entry = it->second;
+
+	if ( entry.dialog == dialog && entry.dirty )
+	    scan( it->first, entry );
+
+	if ( entry.dialog == dialog && entry.items.empty() )
+	{
+	    // Nothing to watch anymore until the items are changed again
+
+	    it = _trees.erase( it );
+	    continue;
+	}
+
+	if ( entry.dialog == dialog )
+	    return true;
+
+	++it;
+    }
+
+    return false;
+}
+
+
+YEvent *
+YCPLazyTreeItems::openedItemEvent( YDialog * dialog )
+{
+    deleteLastEvent();
+
+    for ( TreeMap::iterator it = _trees.begin(); it != _trees.end(); ++it )
+    {
+	Entry & entry = it->second;
+
+	if ( entry.dialog != dialog )
+	    continue;
+
+	if ( entry.dirty )
+	    scan( it->first, entry );
+
+	for ( size_t i=0; i < entry.items.size(); i++ )
+	{
+	    YCPTreeItem * item = entry.items[i];
+
+	    if ( item->isOpen() )
+	    {
+		entry.items.erase( entry.items.begin() + i );
+		_lastEvent = new YCPLazyTreeItemEvent( it->first, item );
+
+		yuiDebug() << "Lazy item \"" << item->YTreeItem::label()
+			   << "\" opened in " << it->first << endl;
+
+		return _lastEvent;
+	    }
+	}
+    }
+
+    return 0;
+}
+
+
+void
+YCPLazyTreeItems::removeChildren( YWidget * widget )
+{
+    TreeMap::iterator it = _trees.begin();
+
+    while ( it != _trees.end() )
+    {
+	// Is 'widget' an ancestor of this tree?
+
+	YWidget * parent = it->first->parent();
+
+	while ( parent && parent != widget )
+	    parent = parent->parent();
+
+	if ( parent )
+	{
+	    if ( _lastEvent && _lastEvent->widget() == it->first )
+		deleteLastEvent();
+
+	    it = _trees.erase( it );
+	}
+	else
+	    ++it;
+    }
+}
+
+
+void
+YCPLazyTreeItems::removeDialog( YDialog * dialog )
+{
+    TreeMap::iterator it = _trees.begin();
+
+    while ( it != _trees.end() )
+    {
+	if ( it->second.dialog == dialog )
+	    it = _trees.erase( it );
+	else
+	    ++it;
+    }
+
+    deleteLastEvent();
+}
+
+
+void
+YCPLazyTreeItems::scan( YTree * tree, Entry & entry )
+{
+    entry.items.clear();
+    entry.dirty = false;
+
+    // Iterative depth-first traversal: Trees may be very deep
+
+    typedef std::pair<YItemConstIterator, YItemConstIterator> Range;
+    std::vector<Range> stack;
+
+    stack.push_back( Range( tree->itemsBegin(), tree->itemsEnd() ) );
+
+    while ( ! stack.empty() )
+    {
+	Range & range = stack.back();
+
+	if ( range.first == range.second )
+	{
+	    stack.pop_back();
+	    continue;
+	}
+
+	YItem * item = *( range.first );
+	++range.first;
+
+	YCPTreeItem * treeItem = dynamic_cast<YCPTreeItem *>( item );
+
+	if ( treeItem && treeItem->isLazy() )
+	    entry.items.push_back( treeItem ); // its only child is the placeholder
+	else if ( item->hasChildren() )
+	    stack.push_back( Range( item->childrenBegin(), item->childrenEnd() ) );
+    }
+}
+
+
+void
+YCPLazyTreeItems::deleteLastEvent()
+{
+    if ( _lastEvent )
+    {
+	delete _lastEvent;
+	_lastEvent = 0;
+    }
+}
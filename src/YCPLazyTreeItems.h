@@ -0,0 +1,174 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPLazyTreeItems.h
+
+		Tree items whose children are supplied when the user opens them.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPLazyTreeItems_h
+#define YCPLazyTreeItems_h
+
+#include <vector>
+#include <unordered_map>
+#include <ycp/YCPList.h>
+#include <yui/YEvent.h>
+
+class YWidget;
+class YDialog;
+class YTree;
+class YCPTreeItem;
+
+
+/**
+ * Symbol for tree items: The children are supplied later.
+ **/
+#define YCPSymbol_lazy		"lazy"
+
+
+/**
+ * Event that is sent when the user opens a lazy tree item:
+ * EventReason "Expanded", ItemID the ID of that item.
+ *
+ * This is only a YWidgetEvent with reason Activated because there is no
+ * better one in YEvent::EventReason. Only YCPEvent looks at it (and
+ * replaces that reason), and it is only returned by UI::WaitForEvent(), never
+ * passed to the UI or to any code that acts on the reason.
+ **/
+class YCPLazyTreeItemEvent: public YWidgetEvent
+{
+public:
+
+    YCPLazyTreeItemEvent( YTree * tree, YCPTreeItem * item );
+
+    virtual ~YCPLazyTreeItemEvent() {}
+
+    /**
+     * Return the tree item that was opened.
+     **/
+    YCPTreeItem * item() const { return _item; }
+
+private:
+
+    YCPTreeItem * _item;
+};
+
+
+/**
+ * Support for tree items with `lazy: Such an item gets only a placeholder
+ * child (so the user can open it), and the application supplies its real
+ * children with ChangeWidget( `id(`tree), `Children( itemId ), [ ... ] )
+ * only when the user opens it.
+ *
+ * The UIs don't send an event when the user opens a tree item, so while
+ * there are lazy items in the current dialog, YCP_UI::waitForEvent() checks
+ * them regularly and returns a YCPLazyTreeItemEvent for each one that was
+ * opened.
+ **/
+class YCPLazyTreeItems
+{
+public:
+
+    /**
+     * Mark 'item' as lazy and give it a placeholder child.
+     **/
+    static void addPlaceholder( YCPTreeItem * item );
+
+    /**
+     * Replace the children of 'item' of 'tree' with the items of
+     * 'childList'. This throws exceptions if there are syntax errors.
+     **/
+    static void setChildren( YTree *		tree,
+			     YCPTreeItem *	item,
+			     const YCPList &	childList );
+
+    /**
+     * Rescan the items of 'tree' for lazy items the next time they are
+     * needed. Call this after changing the items of a tree.
+     **/
+    static void invalidate( YTree * tree );
+
+    /**
+     * Return 'true' if any tree of 'dialog' has lazy items that the user
+     * didn't open yet.
+     **/
+    static bool hasLazyItems( YDialog * dialog );
+
+    /**
+     * Return an event for the first lazy item of any tree of 'dialog' that
+     * the user opened since the last call or 0 if there is none. Each opened
+     * item is reported only once.
+     *
+     * The event remains owned by this class; it is deleted upon the next
+     * call or when the dialog is removed.
+     **/
+    static YEvent * openedItemEvent( YDialog * dialog );
+
+    /**
+     * Forget all trees that are descendants of 'widget' (but not 'widget'
+     * itself). Call this before deleting the children of a widget.
+     **/
+    static void removeChildren( YWidget * widget );
+
+    /**
+     * Forget all trees of 'dialog'. Call this when a dialog is closed or
+     * when a new dialog is created.
+     **/
+    static void removeDialog( YDialog * dialog );
+
+protected:
+
+    struct Entry
+    {
+	YDialog *			dialog;
+	bool				dirty;	// rescan the items
+	std::vector<YCPTreeItem *>	items;	// lazy items not reported yet
+    };
+
+    typedef std::unordered_map<YTree *, Entry> TreeMap;
+
+    /**
+     * Collect all lazy items of 'tree' in 'entry'.
+     **/
+    static void scan( YTree * tree, Entry & entry );
+
+    /**
+     * Delete the last event returned by openedItemEvent().
+     **/
+    static void deleteLastEvent();
+
+private:
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPLazyTreeItems() {}
+
+    static TreeMap			_trees;
+    static YCPLazyTreeItemEvent *	_lastEvent;
+};
+
+
+#endif // YCPLazyTreeItems_h
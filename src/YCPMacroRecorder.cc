@@ -42,6 +42,7 @@ you may find current contact information at www.novell.com
 #include <yui/YUISymbols.h>
 #include <yui/YWidget.h>
 #include <yui/YInputField.h>
+#include <yui/YUIException.h>
 #include "YCPMacroRecorder.h"
 #include "YUIComponent.h"
 #include "YCPValueWidgetID.h"
@@ -358,7 +359,23 @@ void YCPMacroRecorder::recordWidgetProperty( YWidget *    widget,
     }
     else
     {
-	YCPValue val = YCP_UI::QueryWidget( idTerm, YCPSymbol( propertyName ) );
+	// We already have the widget; no need to look it up by its ID again
+	YCPValue val = YCPNull();
+
+	try
+	{
+	    val = YCP_UI::queryWidget( widget, YCPSymbol( propertyName ) );
+	}
+	catch( YUIException & exception )
+	{
+	    YUI_CAUGHT( exception );
+	}
+
+	if ( val.isNull() )
+	{
+	    yuiError() << "Can't get " << propertyName << " of " << widget << endl;
+	    return;
+	}
 
 	fprintf( _macroFile, "%s%sUI::%s( %s,\t`%s,\t%s );\t// %s \"%s\"\n",
 		 // UI::ChangeWidget( `id( `something ), `Value, 42 ) // YWidget
@@ -34,6 +34,7 @@ you may find current contact information at www.novell.com
 #include <ycp/YCPValue.h>
 #include <ycp/YCPString.h>
 #include <yui/YMenuItem.h>
+#include "YCPItemPool.h"
 
 
 /**
@@ -84,6 +85,11 @@ public:
     virtual ~YCPMenuItem()
 	{}
 
+    /**
+     * Allocate items from a pool: There are often very many of them.
+     **/
+    YCP_ITEM_POOL( YCPMenuItem )
+
     /**
      * Return 'true' if this item has an ID.
      **/
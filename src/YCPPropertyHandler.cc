@@ -38,6 +38,8 @@ you may find current contact information at www.novell.com
 #include <ycp/YCPTerm.h>
 #include <ycp/YCPVoid.h>
 
+#include <unordered_set>
+
 #define y2log_component "ui"
 #include <ycp/y2log.h>
 
@@ -45,6 +47,10 @@ you may find current contact information at www.novell.com
 
 #include "YCPDialogParser.h"
 #include "YCPItem.h"
+#include "YCPItemIndex.h"
+#include "YCPItemsCache.h"
+#include "YCPLazyTableItems.h"
+#include "YCPLazyTreeItems.h"
 #include "YCPTreeItem.h"
 #include "YCPItemParser.h"
 #include "YCPItemWriter.h"
@@ -59,6 +65,7 @@ you may find current contact information at www.novell.com
 #include <yui/YBarGraph.h>
 #include <yui/YCheckBox.h>
 #include <yui/YComboBox.h>
+#include <yui/YDialog.h>
 #include <yui/YDumbTab.h>
 #include <yui/YItemSelector.h>
 #include <yui/YMenuWidget.h>
@@ -74,72 +81,266 @@ you may find current contact information at www.novell.com
 
 
 
-bool
-YCPPropertyHandler::setComplexProperty( YWidget *		widget,
-					const string &		propertyName,
-					const YCPValue &	val )
+YCPPropertyHandler::WidgetClassMap		YCPPropertyHandler::_propertyTypes;
+YCPPropertyHandler::KnownSetterMap		YCPPropertyHandler::_knownSetters;
+YCPPropertyHandler::KnownGetterMap		YCPPropertyHandler::_knownGetters;
+
+
+YPropertyType
+YCPPropertyHandler::propertyType( YWidget * widget, const string & propertyName )
 {
-    // y2debug( "%s::%s", widget->widgetClass(), propertyName.c_str() );
+    PropertyTypeMap & propertyTypes = _propertyTypes[ widget->widgetClass() ];
+    PropertyTypeMap::const_iterator it = propertyTypes.find( propertyName );
 
-    if ( propertyName == YUIProperty_Value )
+    if ( it != propertyTypes.end() )
+	return it->second;
+
+    YPropertyType type = YUnknownPropertyType;
+    const YPropertySet & propSet = widget->propertySet();
+
+    for ( YPropertySet::const_iterator prop = propSet.propertiesBegin();
+	  prop != propSet.propertiesEnd();
+	  ++prop )
     {
-	if ( trySetCheckBoxValue	( widget, val ) )		return true;
-	if ( trySetSelectionBoxValue	( widget, val ) )		return true;
-	if ( trySetItemSelectorValue	( widget, val ) )		return true;
-	if ( trySetTreeValue		( widget, val ) )		return true;
-	if ( trySetTableValue		( widget, val ) )		return true;
-	if ( trySetComboBoxValue	( widget, val ) )		return true;
-	if ( trySetDumbTabValue		( widget, val ) )		return true;
-	if ( trySetRadioButtonGroupCurrentButton( widget, val ) )	return true;
+	if ( prop->name() == propertyName )
+	{
+	    type = prop->type();
+	    break;
+	}
     }
-    else if ( propertyName == YUIProperty_Values )
+
+    propertyTypes[ propertyName ] = type;
+
+    return type;
+}
+
+
+bool
+YCPPropertyHandler::isBindingsProperty( const string & propertyName )
+{
+    return propertyName == YCPProperty_ItemsDiff ||
+	propertyName == YCPProperty_ItemIds   ||
+	propertyName == YCPProperty_Cells;
+}
+
+
+YCPPropertyHandler::PropertySetterMap
+YCPPropertyHandler::createPropertySetterMap()
+{
+    PropertySetterMap setters;
+
+    // The handlers for each property are tried in this order until one of
+    // them succeeds. Where several handlers could accept the same widget
+    // (because of inheritance), the more specific one must come first.
+
+    setters[ YUIProperty_Value ] =
     {
-	if ( trySetMultiProgressMeterValues ( widget, val ) )		return true;
-	if ( trySetBarGraphValues	( widget, val ) )		return true;
-    }
-    else if ( propertyName == YUIProperty_Labels )
+	trySetCheckBoxValue,
+	trySetSelectionBoxValue,
+	trySetItemSelectorValue,
+	trySetTreeValue,
+	trySetTableValue,
+	trySetComboBoxValue,
+	trySetDumbTabValue,
+	trySetRadioButtonGroupCurrentButton
+    };
+
+    setters[ YUIProperty_Values ] =
     {
-	if ( trySetBarGraphLabels	( widget, val ) )		return true;
-    }
-    else if ( propertyName == YUIProperty_CurrentItem )
+	trySetMultiProgressMeterValues,
+	trySetBarGraphValues
+    };
+
+    setters[ YUIProperty_Labels ] =
     {
-	if ( trySetSelectionBoxValue	( widget, val ) )		return true;
-	if ( trySetItemSelectorValue	( widget, val ) )		return true;
-	if ( trySetTreeValue		( widget, val ) )		return true;
-	if ( trySetTableValue		( widget, val ) )		return true;
-	if ( trySetDumbTabValue		( widget, val ) )		return true;
+	trySetBarGraphLabels
+    };
 
-	if ( trySetMultiSelectionBoxCurrentItem ( widget, val ) )	return true;
-    }
-    else if ( propertyName == YUIProperty_Items )
+    setters[ YUIProperty_CurrentItem ] =
     {
-	// Make sure to try YMenuWidget, YTable, YTree, before YSelectionWidget:
-	// they all inherit YSelectionWidget!
+	trySetSelectionBoxValue,
+	trySetItemSelectorValue,
+	trySetTreeValue,
+	trySetTableValue,
+	trySetDumbTabValue,
+	trySetMultiSelectionBoxCurrentItem
+    };
 
-	if ( trySetMenuWidgetItems	( widget, val ) )		return true;
-	if ( trySetTreeItems		( widget, val ) )		return true;
-	if ( trySetTableItems		( widget, val ) )		return true;
-	if ( trySetItemSelectorItems	( widget, val ) )		return true;
-	if ( trySetSelectionWidgetItems	( widget, val ) )		return true;
-    }
-    else if ( propertyName == YUIProperty_ItemStatus )
+    // Make sure to try YMenuWidget, YTable, YTree, before YSelectionWidget:
+    // they all inherit YSelectionWidget!
+
+    setters[ YUIProperty_Items ] =
     {
-	if ( trySetSelectionWidgetItemStatus	( widget, val ) )	return true;
-    }
-    else if ( propertyName == YUIProperty_CurrentButton )
+	trySetMenuWidgetItems,
+	trySetTreeItems,
+	trySetTableItems,
+	trySetItemSelectorItems,
+	trySetSelectionWidgetItems
+    };
+
+    setters[ YUIProperty_ItemStatus ] =
     {
-	if ( trySetRadioButtonGroupCurrentButton( widget, val ) )	return true;
-    }
-    else if ( propertyName == YUIProperty_SelectedItems )
+	trySetSelectionWidgetItemStatus
+    };
+
+    setters[ YUIProperty_CurrentButton ] =
     {
-	if ( trySetMultiSelectionBoxSelectedItems( widget, val ) )	return true;
-	if ( trySetItemSelectorSelectedItems	 ( widget, val ) )	return true;
-	if ( trySetTableSelectedItems		 ( widget, val ) )	return true;
-	if ( trySetTreeSelectedItems		 ( widget, val ) )	return true;
-    }
-    else if ( propertyName == YUIProperty_EnabledItems )
+	trySetRadioButtonGroupCurrentButton
+    };
+
+    setters[ YUIProperty_SelectedItems ] =
+    {
+	trySetMultiSelectionBoxSelectedItems,
+	trySetItemSelectorSelectedItems,
+	trySetTableSelectedItems,
+	trySetTreeSelectedItems
+    };
+
+    setters[ YUIProperty_EnabledItems ] =
+    {
+	trySetMenuWidgetEnabledItems
+    };
+
+    setters[ YCPProperty_Cells ] =
+    {
+	trySetTableCells
+    };
+
+    setters[ YCPProperty_ItemsDiff ] =
+    {
+	trySetTableItemsDiff,
+	trySetSelectionWidgetItemsDiff
+    };
+
+    return setters;
+}
+
+
+YCPPropertyHandler::PropertyGetterMap
+YCPPropertyHandler::createPropertyGetterMap()
+{
+    PropertyGetterMap getters;
+
+    // See createPropertySetterMap() about the order
+
+    getters[ YUIProperty_Value ] =
+    {
+	tryGetCheckBoxValue,
+	tryGetSelectionBoxValue,
+	tryGetItemSelectorValue,
+	tryGetTreeValue,
+	tryGetTableValue,
+	tryGetComboBoxValue,
+	tryGetDumbTabValue,
+	tryGetRadioButtonGroupCurrentButton
+    };
+
+    getters[ YUIProperty_Values ] =
+    {
+	tryGetBarGraphValues
+    };
+
+    getters[ YUIProperty_CurrentItem ] =
+    {
+	tryGetSelectionBoxValue,
+	tryGetItemSelectorValue,
+	tryGetTreeCurrentItem,
+	tryGetTableValue,
+	tryGetComboBoxValue,
+	tryGetDumbTabValue,
+	tryGetWizardCurrentItem,
+	tryGetMultiSelectionBoxCurrentItem
+    };
+
+    getters[ YUIProperty_CurrentButton ] =
+    {
+	tryGetRadioButtonGroupCurrentButton
+    };
+
+    getters[ YUIProperty_SelectedItems ] =
+    {
+	tryGetItemSelectorSelectedItems,
+	tryGetTableSelectedItems,
+	tryGetTreeSelectedItems,
+	tryGetMultiSelectionBoxSelectedItems
+    };
+
+    getters[ YUIProperty_EnabledItems ] =
+    {
+	tryGetMenuWidgetEnabledItems
+    };
+
+    getters[ YUIProperty_OpenItems ] =
+    {
+	tryGetOpenItems
+    };
+
+    getters[ YUIProperty_CurrentBranch ] =
+    {
+	tryGetTreeCurrentBranch
+    };
+
+    // Make sure to try YMenuWidget, YTable, YTree, before YSelectionWidget:
+    // they all inherit YSelectionWidget!
+
+    getters[ YUIProperty_Items ] =
+    {
+	tryGetMenuWidgetItems,
+	tryGetTableItems,
+	tryGetTreeItems,
+	tryGetItemSelectorItems,
+	tryGetSelectionWidgetItems
+    };
+
+    getters[ YUIProperty_ItemStatus ] =
+    {
+	tryGetSelectionWidgetItemStatus
+    };
+
+    getters[ YUIProperty_Labels ] =
+    {
+	tryGetBarGraphLabels
+    };
+
+    getters[ YCPProperty_ItemIds ] =
+    {
+	tryGetSelectionWidgetItemIds
+    };
+
+    return getters;
+}
+
+
+bool
+YCPPropertyHandler::setComplexProperty( YWidget *		widget,
+					const string &		propertyName,
+					const YCPValue &	val )
+{
+    // y2debug( "%s::%s", widget->widgetClass(), propertyName.c_str() );
+
+    static const PropertySetterMap setterMap = createPropertySetterMap();
+    PropertySetterMap::const_iterator setters = setterMap.find( propertyName );
+
+    if ( setters != setterMap.end() )
     {
-	if ( trySetMenuWidgetEnabledItems( widget, val ) )              return true;
+	// Try the handler that worked last time for this widget class first.
+	// Only if it fails, try all of them in the usual order.
+
+	PropertySetter & knownSetter = _knownSetters[ widget->widgetClass() ][ propertyName ];
+
+	if ( knownSetter && knownSetter( widget, val ) )
+	    return true;
+
+	for ( PropertySetterList::const_iterator it = setters->second.begin();
+	      it != setters->second.end();
+	      ++it )
+	{
+	    if ( *it != knownSetter && (*it)( widget, val ) )
+	    {
+		knownSetter = *it;
+		return true;
+	    }
+	}
     }
 
     y2error( "Can't handle property %s::%s - not changing anything",
@@ -161,6 +362,10 @@ YCPPropertyHandler::setComplexProperty( YWidget *		widget,
     {
 	if ( trySetTableCell( widget, propertyTerm, val ) )	return true;
     }
+    else if ( propertyName == YCPProperty_Children )
+    {
+	if ( trySetTreeChildren( widget, propertyTerm, val ) )	return true;
+    }
 
     y2error( "Can't handle property %s::%s - not changing anything",
 	     widget->widgetClass(), propertyName.c_str() );
@@ -174,76 +379,53 @@ YCPPropertyHandler::setComplexProperty( YWidget *		widget,
 YCPValue
 YCPPropertyHandler::getComplexProperty( YWidget * widget, const string & propertyName )
 {
-    YCPValue val = YCPNull();
+    static const PropertyGetterMap getterMap = createPropertyGetterMap();
+    PropertyGetterMap::const_iterator getters = getterMap.find( propertyName );
 
-    if ( propertyName == YUIProperty_Value )
-    {
-	val = tryGetCheckBoxValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetSelectionBoxValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetItemSelectorValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTreeValue		( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTableValue		( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetComboBoxValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetDumbTabValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetRadioButtonGroupCurrentButton( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_Values )
-    {
-	val = tryGetBarGraphValues	( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_CurrentItem )
-    {
-	val = tryGetSelectionBoxValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetItemSelectorValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTreeCurrentItem	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTableValue		( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetComboBoxValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetDumbTabValue	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetWizardCurrentItem	( widget );	if ( ! val.isNull() ) return val;
+    // The Items of an unchanged widget don't need to be created again
 
-	val = tryGetMultiSelectionBoxCurrentItem( widget ); if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_CurrentButton )
-    {
-	val = tryGetRadioButtonGroupCurrentButton( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_SelectedItems )
-    {
-	val = tryGetItemSelectorSelectedItems	( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTableSelectedItems		( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTreeSelectedItems		( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetMultiSelectionBoxSelectedItems( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_EnabledItems )
-    {
-	val = tryGetMenuWidgetEnabledItems      ( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_OpenItems )
-    {
-	val = tryGetOpenItems           ( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_CurrentBranch )
-    {
-	val = tryGetTreeCurrentBranch	( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_Items )
-    {
-	// Make sure to try YMenuWidget, YTable, YTree, before YSelectionWidget:
-	// they all inherit YSelectionWidget!
+    YSelectionWidget * itemsWidget = 0;
 
-	val = tryGetMenuWidgetItems		( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTableItems			( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetTreeItems			( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetItemSelectorItems		( widget );	if ( ! val.isNull() ) return val;
-	val = tryGetSelectionWidgetItems	( widget );	if ( ! val.isNull() ) return val;
-    }
-    else if ( propertyName == YUIProperty_ItemStatus )
+    if ( propertyName == YUIProperty_Items )
     {
-	val = tryGetSelectionWidgetItemStatus	( widget );	if ( ! val.isNull() ) return val;
+	itemsWidget = dynamic_cast<YSelectionWidget *>( widget );
+
+	if ( itemsWidget )
+	{
+	    YCPValue cached = YCPItemsCache::lookup( itemsWidget );
+
+	    if ( ! cached.isNull() )
+		return cached;
+	}
     }
-    else if ( propertyName == YUIProperty_Labels )
+
+    if ( getters != getterMap.end() )
     {
-	val = tryGetBarGraphLabels	( widget );	if ( ! val.isNull() ) return val;
+	// See setComplexProperty()
+
+	PropertyGetter & knownGetter = _knownGetters[ widget->widgetClass() ][ propertyName ];
+	YCPValue val = knownGetter ? knownGetter( widget ) : YCPNull();
+
+	for ( PropertyGetterList::const_iterator it = getters->second.begin();
+	      val.isNull() && it != getters->second.end();
+	      ++it )
+	{
+	    if ( *it == knownGetter )
+		continue;
+
+	    val = (*it)( widget );
+
+	    if ( ! val.isNull() )
+		knownGetter = *it;
+	}
+
+	if ( ! val.isNull() )
+	{
+	    if ( itemsWidget )
+		YCPItemsCache::store( itemsWidget, val );
+
+	    return val;
+	}
     }
 
     y2error( "Can't handle property %s::%s - returning 'nil'",
@@ -265,6 +447,10 @@ YCPPropertyHandler::getComplexProperty( YWidget * widget, const YCPTerm & proper
     {
 	val = tryGetTableCell	( widget, propertyTerm );	if ( ! val.isNull() ) return val;
     }
+    else if ( propertyName == YUIProperty_Items )
+    {
+	val = tryGetTableItemColumns( widget, propertyTerm );	if ( ! val.isNull() ) return val;
+    }
 
     y2error( "Can't handle property %s::%s - returning 'nil'",
 	     widget->widgetClass(), propertyName.c_str() );
@@ -303,32 +489,11 @@ YCPPropertyHandler::trySetCheckBoxValue( YWidget * widget, const YCPValue & val
 }
 
 
-template<class Item_t>
-Item_t * findItem( const YCPValue &	wantedId,
-		   YItemConstIterator	begin,
-		   YItemConstIterator	end )
-{
-    for ( YItemConstIterator it = begin; it != end; ++it )
-    {
-	Item_t * item = dynamic_cast<Item_t *> (*it);
-
-	if ( item && item->hasId() && wantedId->equal( item->id() ) )
-	    return item;
-
-	if ( (*it)->hasChildren() )
-	{
-	    Item_t * result = findItem<Item_t>( wantedId,
-						(*it)->childrenBegin(),
-						(*it)->childrenEnd() );
-	    if ( result )
-		return result;
-	}
-    }
-
-    return 0;
-}
-
-
+/**
+ * Find the item with ID 'val' (which may also be `id(...)) in 'selWidget'
+ * (including all tree item children) and return it if it is an 'Item_t'.
+ * Return 0 if there is no such item.
+ **/
 template<class Item_t>
 Item_t * findItem( YSelectionWidget * selWidget, const YCPValue & val )
 {
@@ -339,7 +504,7 @@ Item_t * findItem( YSelectionWidget * selWidget, const YCPValue & val )
 	wantedId = val->asTerm()->value(0);
     }
 
-    return findItem<Item_t>( wantedId, selWidget->itemsBegin(), selWidget->itemsEnd() );
+    return dynamic_cast<Item_t *>( YCPItemIndex::findItem( selWidget, wantedId ) );
 }
 
 
@@ -464,6 +629,8 @@ YCPPropertyHandler::trySetItemSelectorItems( YWidget * widget, const YCPValue &
     if ( val->isList() )
     {
 	itemSelector->setItems( YCPItemParser::parseDescribedItemList( val->asList() ) );
+	YCPItemIndex::invalidate( itemSelector );
+	YCPItemsCache::invalidate( itemSelector );
 	return true;
     }
 
@@ -475,238 +642,806 @@ YCPPropertyHandler::trySetItemSelectorItems( YWidget * widget, const YCPValue &
 
 
 bool
-YCPPropertyHandler::trySetSelectionWidgetItems( YWidget * widget, const YCPValue & val )
+YCPPropertyHandler::trySetSelectionWidgetItems( YWidget * widget, const YCPValue & val )
+{
+    YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
+
+    if ( ! selWidget )
+	return false;
+
+    if ( val->isList() )
+    {
+	selWidget->setItems( YCPItemParser::parseItemList( val->asList() ) );
+	YCPItemIndex::invalidate( selWidget );
+	YCPItemsCache::invalidate( selWidget );
+	return true;
+    }
+
+    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
+						      YOtherProperty ),
+					   widget ) );
+    return false;
+}
+
+
+bool
+YCPPropertyHandler::trySetMenuWidgetItems( YWidget * widget, const YCPValue & val )
+{
+    YMenuWidget * menuWidget = dynamic_cast<YMenuWidget *> (widget );
+
+    if ( ! menuWidget )
+	return false;
+
+    if ( val->isList() )
+    {
+	menuWidget->setItems( YCPMenuItemParser::parseMenuItemList( val->asList() ) );
+	YCPItemIndex::invalidate( menuWidget );
+	YCPItemsCache::invalidate( menuWidget );
+	return true;
+    }
+
+    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
+						      YOtherProperty ),
+					   widget ) );
+    return false;
+}
+
+
+bool
+YCPPropertyHandler::trySetTreeItems( YWidget * widget, const YCPValue & val )
+{
+    YTree * tree = dynamic_cast<YTree *> (widget );
+
+    if ( ! tree )
+	return false;
+
+    if ( val->isList() )
+    {
+	tree->setItems( YCPTreeItemParser::parseTreeItemList( val->asList() ) );
+	YCPItemIndex::invalidate( tree );
+	YCPItemsCache::invalidate( tree );
+	YCPLazyTreeItems::invalidate( tree );
+	return true;
+    }
+
+    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_ItemStatus,
+						      YOtherProperty ),
+					   widget ) );
+    return false;
+}
+
+
+bool
+YCPPropertyHandler::trySetTreeChildren( YWidget * widget, const YCPTerm & propTerm, const YCPValue & val )
+{
+    YTree * tree = dynamic_cast<YTree *> (widget );
+
+    if ( ! tree )
+	return false;
+
+    if ( propTerm->size() == 1 && val->isList() )
+    {
+	YCPValue      itemId = propTerm->value(0);
+	YCPTreeItem * item   = findItem<YCPTreeItem>( tree, itemId );
+
+	if ( ! item )
+	{
+	    y2error( "%s %s has no item with ID %s",
+		     tree->widgetClass(),
+		     tree->debugLabel().c_str(),
+		     itemId->toString().c_str() );
+
+	    return true; // just like `Cell(): not an argument error
+	}
+
+	YCPLazyTreeItems::setChildren( tree, item, val->asList() );
+
+	return true;
+    }
+
+    string msg = "Expected `Children( itemId ), [ `item(...), ... ], not ";
+    YUI_THROW( YUIBadPropertyArgException( YProperty( YCPProperty_Children,
+						      YOtherProperty ),
+					   widget, msg + val->toString() ) );
+    return false;
+}
+
+
+bool
+YCPPropertyHandler::trySetSelectionWidgetItemStatus( YWidget * widget, const YCPValue & val )
+{
+    YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
+
+    if ( ! selWidget )
+	return false;
+
+    bool ok = val->isMap();
+
+    if ( ok )
+	ok = setItemStatus( selWidget, val->asMap() );
+
+    if ( ! ok )
+    {
+	YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_ItemStatus,
+							  YOtherProperty ),
+					       widget ) );
+    }
+
+    return ok;
+}
+
+
+bool
+YCPPropertyHandler::setItemStatus( YSelectionWidget *	widget,
+				   const YCPMap &	statusMap )
+{
+    typedef std::pair<YItem *, int> ItemStatus;
+
+    vector<ItemStatus> changes;
+    changes.reserve( statusMap->size() );
+    bool ok = true;
+
+    // Resolve all items first: Each lookup is a hash lookup in the item
+    // index, and the index is built with only one walk through all items.
+
+    for ( YCPMap::const_iterator it = statusMap->begin();
+	  it != statusMap->end();
+	  ++it )
+    {
+	const YCPValue & itemId	   = it->first;
+	const YCPValue & newStatus = it->second;
+	int status;
+
+	if ( newStatus->isInteger() )
+	    status = newStatus->asInteger()->value();
+	else if ( newStatus->isBoolean() )
+	    status = newStatus->asBoolean()->value() ? 1 : 0;
+	else
+	{
+	    y2error( "Setting ItemStatus for item with ID %s: "
+		     "Expected integer or boolean, not %s",
+		     itemId->toString().c_str(), newStatus->toString().c_str() );
+
+	    return false; // nothing changed yet
+	}
+
+	YItem * item = findItem<YCPItem>( widget, itemId );
+
+	if ( item )
+	{
+	    changes.push_back( ItemStatus( item, status ) );
+	}
+	else
+	{
+	    y2error( "%s %s has no item with ID %s",
+		     widget->widgetClass(),
+		     widget->debugLabel().c_str(),
+		     itemId->toString().c_str() );
+
+	    ok = false;
+	}
+    }
+
+    if ( ! ok || changes.empty() )
+	return ok; // nothing changed
+
+    // Apply all changes with only one screen update for all of them
+
+    YDialog * dialog = widget->findDialog();
+
+    if ( dialog )
+    {
+	YWidget::OptimizeChanges below( *dialog ); // delay screen updates until this block is left
+
+	for ( size_t i=0; i < changes.size(); i++ )
+	    widget->setItemStatus( changes[i].first, changes[i].second );
+    }
+    else
+    {
+	for ( size_t i=0; i < changes.size(); i++ )
+	    widget->setItemStatus( changes[i].first, changes[i].second );
+    }
+
+    return true;
+}
+
+
+bool
+YCPPropertyHandler::trySetTableItems( YWidget * widget, const YCPValue & val )
+{
+    YTable * table = dynamic_cast<YTable *> (widget );
+
+    if ( ! table )
+	return false;
+
+    if ( val->isList() )
+    {
+	if ( YCPLazyTableItems::isLazy( table ) )
+	{
+	    YCPLazyTableItems::setItems( table, val->asList() );
+	}
+	else
+	{
+	    table->setItems( YCPTableItemParser::parseTableItemList( val->asList() ) );
+	    YCPItemIndex::invalidate( table );
+	    YCPItemsCache::invalidate( table );
+	}
+
+	return true;
+    }
+
+    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
+						      YOtherProperty ),
+					   widget ) );
+    return false;
+}
+
+
+bool
+YCPPropertyHandler::trySetTableCell( YWidget * widget, const YCPTerm & propTerm, const YCPValue & val )
+{
+    YTable * table = dynamic_cast<YTable *> (widget );
+
+    if ( ! table )
+	return false;
+
+    if ( propTerm->size() == 2 &&
+	 propTerm->value(1)->isInteger() )
+    {
+	YCPValue	itemId = propTerm->value(0);
+	int		column = propTerm->value(1)->asInteger()->value();
+
+	YTableCell * cell = findTableCell( table, itemId, column );
+
+	if ( cell )
+	{
+	    YCPItemsCache::invalidate( table );
+	    setTableCellValue( table, cell, val, YUIProperty_Item );
+	    table->cellChanged( cell );
+	}
+
+	return true;
+    }
+
+    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
+						      YOtherProperty ),
+					   widget ) );
+    return false;
+}
+
+
+bool
+YCPPropertyHandler::trySetTableCells( YWidget * widget, const YCPValue & val )
+{
+    YTable * table = dynamic_cast<YTable *> (widget );
+
+    if ( ! table )
+	return false;
+
+    // Check all entries (including the values) first so nothing is changed
+    // if any of them is bad
+
+    bool ok = val->isList();
+
+    for ( int i=0; ok && i < val->asList()->size(); i++ )
+    {
+	YCPValue entry = val->asList()->value(i);
+
+	ok = entry->isList()					// [ itemId, column, value ]
+	    && entry->asList()->size() == 3
+	    && entry->asList()->value(1)->isInteger()
+	    && isTableCellValue( entry->asList()->value(2) );
+    }
+
+    if ( ! ok )
+    {
+	string msg = "Expected [ [ itemId, column, value ], ... ] "
+	    "with string, integer, or `icon(\"myicon.png\") values, not ";
+	YUI_THROW( YUIBadPropertyArgException( YProperty( YCPProperty_Cells,
+							  YOtherProperty ),
+					       widget, msg + val->toString() ) );
+    }
+
+    YCPItemsCache::invalidate( table );
+    YDialog * dialog = table->findDialog();
+
+    if ( dialog )
+    {
+	YWidget::OptimizeChanges below( *dialog ); // delay screen updates until this block is left
+	setTableCells( table, val->asList() );
+    }
+    else
+    {
+	setTableCells( table, val->asList() );
+    }
+
+    return true;
+}
+
+
+void
+YCPPropertyHandler::setTableCells( YTable * table, const YCPList & cells )
+{
+    vector<YTableCell *>	     changedCells;
+    std::unordered_set<YTableCell *> seen;
+
+    for ( int i=0; i < cells->size(); i++ )
+    {
+	YCPList	     entry  = cells->value(i)->asList();
+	int	     column = entry->value(1)->asInteger()->value();
+	YTableCell * cell   = findTableCell( table, entry->value(0), column );
+
+	// Notify the table only once for each cell that really changed
+
+	if ( cell && setTableCellValue( table, cell, entry->value(2), YCPProperty_Cells ) )
+	{
+	    if ( seen.insert( cell ).second )
+		changedCells.push_back( cell );
+	}
+    }
+
+    for ( size_t i=0; i < changedCells.size(); i++ )
+	table->cellChanged( changedCells[i] );
+}
+
+
+YTableCell *
+YCPPropertyHandler::findTableCell( YTable * table, const YCPValue & itemId, int column )
+{
+    YCPTableItem * item = findItem<YCPTableItem>( table, itemId );
+
+    if ( ! item )
+    {
+	y2error( "%s %s has no item with ID %s",
+		 table->widgetClass(),
+		 table->debugLabel().c_str(),
+		 itemId->toString().c_str() );
+
+	return 0;
+    }
+
+    YTableCell * cell = item->cell( column );
+
+    if ( ! cell )
+    {
+	y2error( "%s item %s doesn't have a column #%d",
+		 table->widgetClass(),
+		 itemId->toString().c_str(),
+		 column );
+    }
+
+    return cell;
+}
+
+
+bool
+YCPPropertyHandler::isTableCellValue( const YCPValue & val )
+{
+    return val->isString()
+	|| val->isInteger()	// for backwards compatibility
+	|| val->isVoid()	// for backwards compatibility
+	|| ( val->isTerm()
+	     && val->asTerm()->name() == YUISymbol_icon // `icon()
+	     && val->asTerm()->size() == 1
+	     && val->asTerm()->value(0)->isString() );
+}
+
+
+bool
+YCPPropertyHandler::setTableCellValue( YTable *		table,
+				       YTableCell *	cell,
+				       const YCPValue &	val,
+				       const string &	propertyName )
+{
+    string oldLabel    = cell->label();
+    string oldIconName = cell->iconName();
+
+    if ( val->isString() )
+    {
+	cell->setLabel( val->asString()->value() );
+    }
+    else if ( val->isInteger() )	// for backwards compatibility
+    {
+	cell->setLabel( val->toString().c_str() );
+    }
+    else if ( val->isVoid() )		// for backwards compatibility
+    {
+	cell->setLabel( "" );
+    }
+    else if ( val->isTerm()
+	      && val->asTerm()->name() == YUISymbol_icon // `icon()
+	      && val->asTerm()->size() == 1
+	      && val->asTerm()->value(0)->isString() )
+    {
+	YCPString iconName = val->asTerm()->value(0)->asString();
+	cell->setIconName( iconName->value().c_str() );
+    }
+    else // any other type
+    {
+	string msg = "Expected string, integer, or `icon(\"myicon.png\"), not ";
+	msg += val->toString().c_str();
+	YUI_THROW( YUIBadPropertyArgException( YProperty( propertyName,
+							  YOtherProperty ),
+					       table, msg ) );
+    }
+
+    return cell->label() != oldLabel || cell->iconName() != oldIconName;
+}
+
+
+bool
+YCPPropertyHandler::trySetTableItemsDiff( YWidget * widget, const YCPValue & val )
+{
+    YTable * table = dynamic_cast<YTable *> (widget );
+
+    if ( ! table )
+	return false;
+
+    YCPList addList;
+    YCPList removeList;
+    YCPList updateList;
+
+    parseItemsDiff( widget, val, addList, removeList, updateList );
+
+    // libyui can't remove single items, and cells can only be changed in
+    // place if the structure of the item doesn't change.
+
+    if ( removeList->size() > 0 || ! updateTableItems( table, updateList ) )
+	return rebuildItems( table, addList, removeList, updateList );
+
+    if ( addList->size() > 0 )
+    {
+	table->addItems( YCPTableItemParser::parseTableItemList( addList ) );
+	YCPItemIndex::invalidate( table );
+	YCPItemsCache::invalidate( table );
+    }
+
+    return true;
+}
+
+
+bool
+YCPPropertyHandler::trySetSelectionWidgetItemsDiff( YWidget * widget, const YCPValue & val )
 {
     YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
 
     if ( ! selWidget )
 	return false;
 
-    if ( val->isList() )
-    {
-	selWidget->setItems( YCPItemParser::parseItemList( val->asList() ) );
-	return true;
-    }
+    YCPList addList;
+    YCPList removeList;
+    YCPList updateList;
 
-    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
-						      YOtherProperty ),
-					   widget ) );
-    return false;
+    parseItemsDiff( widget, val, addList, removeList, updateList );
+
+    return rebuildItems( selWidget, addList, removeList, updateList );
 }
 
 
-bool
-YCPPropertyHandler::trySetMenuWidgetItems( YWidget * widget, const YCPValue & val )
+void
+YCPPropertyHandler::parseItemsDiff( YWidget *		widget,
+				    const YCPValue &	val,
+				    YCPList &		addList,
+				    YCPList &		removeList,
+				    YCPList &		updateList )
 {
-    YMenuWidget * menuWidget = dynamic_cast<YMenuWidget *> (widget );
+    string msg = "Expected $[ \"add\": [...], \"remove\": [...], \"update\": [...] ], not ";
 
-    if ( ! menuWidget )
-	return false;
+    if ( ! val->isMap() )
+    {
+	YUI_THROW( YUIBadPropertyArgException( YProperty( YCPProperty_ItemsDiff,
+							  YOtherProperty ),
+					       widget, msg + val->toString() ) );
+    }
 
-    if ( val->isList() )
+    YCPMap diffMap = val->asMap();
+
+    for ( YCPMap::const_iterator it = diffMap->begin(); it != diffMap->end(); ++it )
     {
-	menuWidget->setItems( YCPMenuItemParser::parseMenuItemList( val->asList() ) );
-	return true;
+	YCPValue key	= it->first;
+	YCPValue value	= it->second;
+	bool	 ok	= key->isString() && value->isList();
+
+	if ( ok )
+	{
+	    string keyName = key->asString()->value();
+
+	    if	    ( keyName == "add"    )	addList	   = value->asList();
+	    else if ( keyName == "remove" )	removeList = value->asList();
+	    else if ( keyName == "update" )	updateList = value->asList();
+	    else ok = false;
+	}
+
+	if ( ! ok )
+	{
+	    YUI_THROW( YUIBadPropertyArgException( YProperty( YCPProperty_ItemsDiff,
+							      YOtherProperty ),
+						   widget, msg + val->toString() ) );
+	}
     }
 
-    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
-						      YOtherProperty ),
-					   widget ) );
-    return false;
+    checkAddedItemIds( widget, addList, removeList );
 }
 
 
-bool
-YCPPropertyHandler::trySetTreeItems( YWidget * widget, const YCPValue & val )
+void
+YCPPropertyHandler::checkAddedItemIds( YWidget *		widget,
+				       const YCPList &	addList,
+				       const YCPList &	removeList )
 {
-    YTree * tree = dynamic_cast<YTree *> (widget );
+    YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
 
-    if ( ! tree )
-	return false;
+    if ( ! selWidget || addList->size() == 0 )
+	return;
 
-    if ( val->isList() )
+    // Removing an item and adding a new one with the same ID is fine
+
+    YCPMap removeIds;
+
+    for ( int i=0; i < removeList->size(); i++ )
     {
-	tree->setItems( YCPTreeItemParser::parseTreeItemList( val->asList() ) );
-	return true;
+	YCPValue id = removeList->value(i);
+
+	if ( id->isTerm() && id->asTerm()->name() == YUISymbol_id )	// `id(..) ?
+	    id = id->asTerm()->value(0);
+
+	removeIds->add( id, YCPBoolean( true ) );
     }
 
-    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_ItemStatus,
-						      YOtherProperty ),
-					   widget ) );
-    return false;
+    YCPMap addIds;
+
+    for ( int i=0; i < addList->size(); i++ )
+    {
+	YCPValue id = itemTermId( addList->value(i) );
+
+	if ( id.isNull() )
+	    continue;
+
+	bool exists = ! addIds->value( id ).isNull() ||
+	    ( removeIds->value( id ).isNull() && YCPItemIndex::findItem( selWidget, id ) );
+
+	if ( exists )
+	{
+	    string msg = "Item ID to add already exists (use \"update\"): ";
+	    YUI_THROW( YUIBadPropertyArgException( YProperty( YCPProperty_ItemsDiff,
+							      YOtherProperty ),
+						   widget, msg + id->toString() ) );
+	}
+
+	addIds->add( id, YCPBoolean( true ) );
+    }
 }
 
 
 bool
-YCPPropertyHandler::trySetSelectionWidgetItemStatus( YWidget * widget, const YCPValue & val )
+YCPPropertyHandler::updateTableItems( YTable * table, const YCPList & updateList )
 {
-    YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
+    if ( updateList->size() == 0 )
+	return true;
 
-    if ( ! selWidget )
-	return false;
+    YItemCollection newItems = YCPTableItemParser::parseTableItemList( updateList );
+    vector<YCPTableItem *> oldItems;
+    oldItems.reserve( newItems.size() );
+    bool inPlace = true;
 
-    bool ok = val->isMap();
+    // First check if all items can be updated in place, and only then
+    // change anything: Either all of them are changed here, or none.
 
-    if ( ok )
+    for ( YItemIterator it = newItems.begin(); inPlace && it != newItems.end(); ++it )
     {
-	YCPMap statusMap = val->asMap();
+	YCPTableItem * newItem = dynamic_cast<YCPTableItem *>( *it );
+	YCPTableItem * oldItem = findItem<YCPTableItem>( table, newItem->id() );
 
-	for ( YCPMap::const_iterator it = statusMap->begin();
-	      it != statusMap->end() && ok;
-	      ++it )
-	{
-	    ok = setItemStatus( selWidget, it->first, it->second );
-	}
+	inPlace = oldItem
+	    && ! oldItem->hasChildren()
+	    && ! newItem->hasChildren()
+	    && oldItem->cellCount() == newItem->cellCount();
+
+	oldItems.push_back( oldItem );
     }
 
-    if ( ! ok )
+    if ( inPlace )
     {
-	YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_ItemStatus,
-							  YOtherProperty ),
-					       widget ) );
+	YCPItemsCache::invalidate( table );
+
+	for ( size_t i=0; i < oldItems.size(); i++ )
+	{
+	    YCPTableItem * oldItem = oldItems[i];
+	    YCPTableItem * newItem = dynamic_cast<YCPTableItem *>( newItems[i] );
+
+	    for ( int col=0; col < newItem->cellCount(); col++ )
+	    {
+		YTableCell * oldCell = oldItem->cell( col );
+		YTableCell * newCell = newItem->cell( col );
+
+		if ( oldCell->label()	 != newCell->label()	||
+		     oldCell->iconName() != newCell->iconName() ||
+		     oldCell->sortKey()	 != newCell->sortKey()	  )
+		{
+		    oldCell->setLabel	( newCell->label()    );
+		    oldCell->setIconName( newCell->iconName() );
+		    oldCell->setSortKey ( newCell->sortKey()  );
+		    table->cellChanged( oldCell );
+		}
+	    }
+	}
     }
 
-    return ok;
+    for ( YItemIterator it = newItems.begin(); it != newItems.end(); ++it )
+	delete *it;
+
+    return inPlace;
 }
 
 
 bool
-YCPPropertyHandler::setItemStatus( YSelectionWidget *	widget,
-				   const YCPValue &	itemId,
-				   const YCPValue &	newStatus )
+YCPPropertyHandler::rebuildItems( YSelectionWidget *	widget,
+				  const YCPList &	addList,
+				  const YCPList &	removeList,
+				  const YCPList &	updateList )
 {
-    int status;
+    // For a table, QueryWidget( `Items ) doesn't return sort keys and child
+    // items, but they must not get lost here
 
-    if ( newStatus->isInteger() )
-	status = newStatus->asInteger()->value();
-    else if ( newStatus->isBoolean() )
-	status = newStatus->asBoolean()->value() ? 1 : 0;
-    else
-    {
-	y2error( "Setting ItemStatus for item with ID %s: "
-		 "Expected integer or boolean, not %s",
-		 itemId->toString().c_str(), newStatus->toString().c_str() );
+    YTable * table = dynamic_cast<YTable *>( widget );
+    YCPValue items = table ?
+	YCPTableItemWriter::itemList( table->itemsBegin(), table->itemsEnd(), true ) :
+	getComplexProperty( widget, YUIProperty_Items );
 
+    if ( ! items->isList() )
 	return false;
+
+    YCPMap removeIds;
+    YCPMap updates;
+
+    for ( int i=0; i < removeList->size(); i++ )
+    {
+	YCPValue id = removeList->value(i);
+
+	if ( id->isTerm() && id->asTerm()->name() == YUISymbol_id )	// `id(..) ?
+	    id = id->asTerm()->value(0);
+
+	removeIds->add( id, YCPBoolean( true ) );
     }
 
-    YCPItem * item = findItem<YCPItem>( widget, itemId );
+    for ( int i=0; i < updateList->size(); i++ )
+    {
+	YCPValue id = itemTermId( updateList->value(i) );
 
-    if ( ! item )
+	if ( id.isNull() )
+	{
+	    string msg = "Expected `item(`id(...), ...) to update, not ";
+	    YUI_THROW( YUIBadPropertyArgException( YProperty( YCPProperty_ItemsDiff,
+							      YOtherProperty ),
+						   widget, msg + updateList->value(i)->toString() ) );
+	}
+
+	updates->add( id, updateList->value(i) );
+    }
+
+    int hits = 0;
+    YCPList newItems = patchItemList( items->asList(), removeIds, updates, hits );
+
+    if ( hits < removeIds->size() + updates->size() )
     {
-	y2error( "%s %s has no item with ID %s",
+	y2error( "%s %s: %d of the items to remove or update not found",
 		 widget->widgetClass(),
 		 widget->debugLabel().c_str(),
-		 itemId->toString().c_str() );
-
-	return false;
+		 removeIds->size() + updates->size() - hits );
     }
 
-    widget->setItemStatus( item, status );
+    for ( int i=0; i < addList->size(); i++ )
+	newItems->add( addList->value(i) );
 
-    return true;
-}
 
+    // Remember the selected items: Not all item writers return them
 
-bool
-YCPPropertyHandler::trySetTableItems( YWidget * widget, const YCPValue & val )
-{
-    YTable * table = dynamic_cast<YTable *> (widget );
+    YCPList selectedIds;
+    YItemCollection selectedItems = widget->selectedItems();
 
-    if ( ! table )
+    for ( YItemIterator it = selectedItems.begin(); it != selectedItems.end(); ++it )
+    {
+	YCPValue id = YCPItemIndex::itemId( *it );
+
+	if ( ! id.isNull() )
+	    selectedIds->add( id );
+    }
+
+    if ( ! setComplexProperty( widget, YUIProperty_Items, newItems ) )
 	return false;
 
-    if ( val->isList() )
+    YCPLazyTableItems::materialize( widget );	// The selected items might be in any chunk
+
+    for ( int i=0; i < selectedIds->size(); i++ )
     {
-	table->setItems( YCPTableItemParser::parseTableItemList( val->asList() ) );
-	return true;
+	YItem * item = YCPItemIndex::findItem( widget, selectedIds->value(i) );
+
+	if ( item && ! item->selected() )
+	    widget->selectItem( item, true );
     }
 
-    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
-						      YOtherProperty ),
-					   widget ) );
-    return false;
+    return true;
 }
 
 
-bool
-YCPPropertyHandler::trySetTableCell( YWidget * widget, const YCPTerm & propTerm, const YCPValue & val )
+YCPList
+YCPPropertyHandler::patchItemList( const YCPList &	itemList,
+				   const YCPMap &	removeIds,
+				   const YCPMap &	updates,
+				   int &		hits )
 {
-    YTable * table = dynamic_cast<YTable *> (widget );
-
-    if ( ! table )
-	return false;
+    YCPList result;
 
-    if ( propTerm->size() == 2 &&
-	 propTerm->value(1)->isInteger() )
+    for ( int i=0; i < itemList->size(); i++ )
     {
-	YCPValue	itemId = propTerm->value(0);
-	int		column = propTerm->value(1)->asInteger()->value();
+	YCPValue item = itemList->value(i);
+	YCPValue id   = itemTermId( item );
 
-	YCPTableItem * item = findItem<YCPTableItem>( table, itemId );
-
-	if ( item )
+	if ( ! id.isNull() )
 	{
-	    YTableCell * cell = item->cell( column );
-
-	    if ( cell )
+	    if ( ! removeIds->value( id ).isNull() )
 	    {
-		if ( val->isString() )
-		{
-		    cell->setLabel( val->asString()->value() );
-		    table->cellChanged( cell );
-		}
-		else if ( val->isInteger() )	// for backwards compatibility
-		{
-		    cell->setLabel( val->toString().c_str() );
-		    table->cellChanged( cell );
-		}
-		else if ( val->isVoid() )	// for backwards compatibility
-		{
-		    cell->setLabel( "" );
-		    table->cellChanged( cell );
-		}
-		else if ( val->isTerm()
-			  && val->asTerm()->name() == YUISymbol_icon // `icon()
-			  && val->asTerm()->size() == 1
-			  && val->asTerm()->value(0)->isString() )
-		{
-		    YCPString iconName = val->asTerm()->value(0)->asString();
-		    cell->setIconName( iconName->value().c_str() );
-		    table->cellChanged( cell );
-		}
-		else // any other type
-		{
-		    string msg = "Expected string, integer, or `icon(\"myicon.png\"), not ";
-		    msg += val->toString().c_str();
-		    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Item,
-								      YOtherProperty ),
-							   table, msg ) );
-		}
+		hits++;
+		continue;
 	    }
-	    else // ! cell
+
+	    YCPValue newItem = updates->value( id );
+
+	    if ( ! newItem.isNull() )
 	    {
-		y2error( "%s item %s doesn't have a column #%d",
-			 table->widgetClass(),
-			 itemId->toString().c_str(),
-			 column );
+		hits++;
+		result->add( newItem );
+		continue;
 	    }
 	}
-	else // ! item
+
+	if ( item->isTerm() )	// Check the children list of tree items and nested table items
 	{
-	    y2error( "%s %s has no item with ID %s",
-		     table->widgetClass(),
-		     table->debugLabel().c_str(),
-		     itemId->toString().c_str() );
+	    YCPTerm itemTerm = item->asTerm();
+	    YCPTerm newTerm( itemTerm->name() );
+
+	    for ( int arg=0; arg < itemTerm->size(); arg++ )
+	    {
+		if ( itemTerm->value( arg )->isList() )
+		    newTerm->add( patchItemList( itemTerm->value( arg )->asList(), removeIds, updates, hits ) );
+		else
+		    newTerm->add( itemTerm->value( arg ) );
+	    }
+
+	    item = newTerm;
 	}
 
-	return true;
+	result->add( item );
     }
 
-    YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items,
-						      YOtherProperty ),
-					   widget ) );
-    return false;
+    return result;
+}
+
+
+YCPValue
+YCPPropertyHandler::itemTermId( const YCPValue & item )
+{
+    if ( item->isString() )		// "label" is its own ID
+	return item;
+
+    if ( item->isTerm() && item->asTerm()->name() == YUISymbol_item )
+    {
+	YCPTerm itemTerm = item->asTerm();
+
+	for ( int i=0; i < itemTerm->size(); i++ )
+	{
+	    YCPValue arg = itemTerm->value(i);
+
+	    if ( arg->isTerm()
+		 && arg->asTerm()->name() == YUISymbol_id
+		 && arg->asTerm()->size() == 1 )
+	    {
+		return arg->asTerm()->value(0);
+	    }
+	}
+    }
+
+    return YCPNull();
 }
 
 
@@ -1280,42 +2015,56 @@ YCPPropertyHandler::getOpenItems( YCPMap &              openItems,
                                   YItemConstIterator	begin,
                                   YItemConstIterator	end )
 {
-    for ( YItemConstIterator it = begin; it != end; ++it )
+    // Iterative depth-first traversal: Trees may be very deep
+
+    typedef std::pair<YItemConstIterator, YItemConstIterator> Range;
+    vector<Range> stack;
+
+    stack.push_back( Range( begin, end ) );
+
+    while ( ! stack.empty() )
     {
-	YTreeItem * item = dynamic_cast<YTreeItem *>(*it);
+	Range & range = stack.back();
 
-	if ( item )
+	if ( range.first == range.second )
+	{
+	    stack.pop_back();
+	    continue;
+	}
+
+	YTreeItem * item = dynamic_cast<YTreeItem *>( *( range.first ) );
+	++range.first;
+
+	if ( ! item )
+	    continue;
+
+	if ( item->isOpen() )
 	{
-            YTreeItem * yTreeItem = dynamic_cast<YTreeItem *> (item);
+	    YCPTableItem * ycpTableItem = dynamic_cast<YCPTableItem *> (item);
 
-	    if ( yTreeItem->isOpen() )
+	    if ( ycpTableItem )
 	    {
-                YCPTableItem * ycpTableItem = dynamic_cast<YCPTableItem *> (item);
-
-                if ( ycpTableItem )
-                {
-                    if ( ycpTableItem->hasId() )
-                        openItems.add( ycpTableItem->id(), YCPString( "ID" ) );
-                    else
-                        openItems.add( ycpTableItem->label( 0 ), YCPString( "Text" ) );
-                }
-                else
-                {
-                    YCPTreeItem * ycpTreeItem  = dynamic_cast<YCPTreeItem *> (item);
-
-                    if ( ycpTreeItem )
-                    {
-                        if ( ycpTreeItem->hasId() )
-                            openItems.add( ycpTreeItem->id(), YCPString( "ID" ) );
-                        else
-                            openItems.add( ycpTreeItem->label(), YCPString( "Text" ) );
-                    }
-                }
+		if ( ycpTableItem->hasId() )
+		    openItems.add( ycpTableItem->id(), YCPString( "ID" ) );
+		else
+		    openItems.add( ycpTableItem->label( 0 ), YCPString( "Text" ) );
 	    }
+	    else
+	    {
+		YCPTreeItem * ycpTreeItem  = dynamic_cast<YCPTreeItem *> (item);
 
-	    if ( item->hasChildren() )
-		getOpenItems( openItems, item->childrenBegin(), item->childrenEnd() );
+		if ( ycpTreeItem )
+		{
+		    if ( ycpTreeItem->hasId() )
+			openItems.add( ycpTreeItem->id(), YCPString( "ID" ) );
+		    else
+			openItems.add( ycpTreeItem->label(), YCPString( "Text" ) );
+		}
+	    }
 	}
+
+	if ( item->hasChildren() )
+	    stack.push_back( Range( item->childrenBegin(), item->childrenEnd() ) ); // invalidates 'range'
     }
 }
 
@@ -1457,6 +2206,90 @@ YCPPropertyHandler::tryGetTableItem( YWidget * widget, const YCPTerm & propTerm
 }
 
 
+YCPValue
+YCPPropertyHandler::tryGetTableItemColumns( YWidget * widget, const YCPTerm & propTerm )
+{
+    YTable * table = dynamic_cast<YTable *> (widget);
+
+    if ( ! table )
+	return YCPNull();
+
+    // `Items(`columns, [ 0, 2 ] )
+
+    bool ok = propTerm->size() == 2
+	&& propTerm->value(0)->isSymbol()
+	&& propTerm->value(0)->asSymbol()->symbol() == "columns"
+	&& propTerm->value(1)->isList();
+
+    vector<int> columns;
+
+    if ( ok )
+    {
+	YCPList columnList = propTerm->value(1)->asList();
+	columns.reserve( columnList->size() );
+
+	for ( int i=0; ok && i < columnList->size(); i++ )
+	{
+	    ok = columnList->value(i)->isInteger();
+
+	    if ( ok )
+		columns.push_back( columnList->value(i)->asInteger()->value() );
+	}
+    }
+
+    if ( ! ok )
+    {
+	string msg = "Expected `Items(`columns, [ column, ... ] ), not ";
+	YUI_THROW( YUIBadPropertyArgException( YProperty( YUIProperty_Items, YOtherProperty ),
+					       table, msg + propTerm->toString() ) );
+    }
+
+    return YCPTableItemWriter::itemList( table->itemsBegin(), table->itemsEnd(), columns );
+}
+
+
+YCPValue
+YCPPropertyHandler::tryGetSelectionWidgetItemIds( YWidget * widget )
+{
+    YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *> (widget);
+
+    if ( ! selWidget )
+	return YCPNull();
+
+    // All items in depth-first order, i.e. in the same order as in `Items
+
+    typedef std::pair<YItemConstIterator, YItemConstIterator> Range;
+    vector<Range> stack;
+    YCPList itemIds;
+
+    stack.push_back( Range( selWidget->itemsBegin(), selWidget->itemsEnd() ) );
+
+    while ( ! stack.empty() )
+    {
+	Range & range = stack.back();
+
+	if ( range.first == range.second )
+	{
+	    stack.pop_back();
+	    continue;
+	}
+
+	const YItem * item = *( range.first );
+	++range.first;
+
+	YCPValue id = YCPItemIndex::itemId( item );
+
+	if ( ! id.isNull() )
+	    itemIds->add( id );
+
+	if ( item->hasChildren() )
+	    stack.push_back( Range( item->childrenBegin(), item->childrenEnd() ) );
+    }
+
+    return itemIds;
+}
+
+
 YCPValue
 YCPPropertyHandler::tryGetMenuWidgetItems( YWidget * widget )
 {
@@ -1491,7 +2324,7 @@ YCPPropertyHandler::tryGetTreeCurrentItem( YWidget * widget )
     YItem * currentItem = tree->currentItem();
     YCPTreeItem * item = dynamic_cast<YCPTreeItem *> (currentItem);
 
-    if ( item )
+    if ( item && item->hasId() )	// not the placeholder child of a lazy item
 	return item->id();
 
     return YCPVoid();
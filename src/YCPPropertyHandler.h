@@ -34,17 +34,34 @@ you may find current contact information at www.novell.com
 #define YCPPropertyHandler_h
 
 #include <ycp/YCPValue.h>
+#include <ycp/YCPList.h>
 #include <ycp/YCPMap.h>
 #include <ycp/YCPTerm.h>
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include <yui/YItem.h>
+#include <yui/YProperty.h>
 
 using std::string;
+using std::vector;
 
 class YCPItem;
 class YWidget;
 class YSelectionWidget;
 class YMenuWidget;
+class YTable;
+class YTableCell;
+
+
+/**
+ * Properties that are handled only by these bindings, not by libyui, so they
+ * are not in the property set of any widget.
+ **/
+#define YCPProperty_ItemsDiff	"ItemsDiff"
+#define YCPProperty_ItemIds	"ItemIds"
+#define YCPProperty_Cells	"Cells"
+#define YCPProperty_Children	"Children"
 
 
 /**
@@ -95,9 +112,44 @@ public:
     static YCPValue getComplexProperty( YWidget *	widget,
 					const YCPTerm &	propertyTerm );
 
+    /**
+     * Return the type of property 'propertyName' of 'widget' as declared in
+     * its property set or YUnknownPropertyType if the widget doesn't have
+     * that property.
+     *
+     * The result is cached for each widget class, so this is much cheaper
+     * than searching the widget's property set each time.
+     **/
+    static YPropertyType propertyType( YWidget *	widget,
+				       const string &	propertyName );
+
+    /**
+     * Return 'true' if 'propertyName' is a property that only these bindings
+     * know (like YCPProperty_ItemsDiff), 'false' otherwise. Such properties
+     * always have to be handled with setComplexProperty() /
+     * getComplexProperty().
+     **/
+    static bool isBindingsProperty( const string & propertyName );
+
 
 protected:
 
+    typedef bool     (*PropertySetter)( YWidget * widget, const YCPValue & val );
+    typedef YCPValue (*PropertyGetter)( YWidget * widget );
+
+    typedef vector<PropertySetter>	PropertySetterList;
+    typedef vector<PropertyGetter>	PropertyGetterList;
+
+    typedef std::unordered_map<string, PropertySetterList> PropertySetterMap;
+    typedef std::unordered_map<string, PropertyGetterList> PropertyGetterMap;
+
+    /**
+     * Create the tables of trySet..() / tryGet..() handlers for each
+     * property name. They are created only once on first use.
+     **/
+    static PropertySetterMap createPropertySetterMap();
+    static PropertyGetterMap createPropertyGetterMap();
+
     /**
      * All trySet..() functions try to dynamic_cast 'widget' to the expected
      * widget type and then set a property.
@@ -113,8 +165,10 @@ protected:
     static bool trySetComboBoxValue			( YWidget * widget, const YCPValue & val );
     static bool trySetMenuWidgetItems			( YWidget * widget, const YCPValue & val );
     static bool trySetTreeItems				( YWidget * widget, const YCPValue & val );
+    static bool trySetTreeChildren			( YWidget * widget, const YCPTerm  & propTerm, const YCPValue & val );
     static bool trySetTableItems			( YWidget * widget, const YCPValue & val );
     static bool trySetTableCell				( YWidget * widget, const YCPTerm  & propTerm, const YCPValue & val );
+    static bool trySetTableCells			( YWidget * widget, const YCPValue & val );
     static bool trySetItemSelectorItems			( YWidget * widget, const YCPValue & val );
     static bool trySetSelectionWidgetItems		( YWidget * widget, const YCPValue & val );
     static bool trySetSelectionWidgetItemStatus		( YWidget * widget, const YCPValue & val );
@@ -128,6 +182,8 @@ protected:
     static bool trySetBarGraphValues			( YWidget * widget, const YCPValue & val );
     static bool trySetBarGraphLabels			( YWidget * widget, const YCPValue & val );
     static bool trySetMenuWidgetEnabledItems		( YWidget * widget, const YCPValue & val );
+    static bool trySetTableItemsDiff			( YWidget * widget, const YCPValue & val );
+    static bool trySetSelectionWidgetItemsDiff		( YWidget * widget, const YCPValue & val );
 
     /**
      * All tryGet..() functions try to dynamic_cast 'widget' to the expected
@@ -153,6 +209,7 @@ protected:
     static YCPValue tryGetWizardCurrentItem		( YWidget * widget );
     static YCPValue tryGetTableCell			( YWidget * widget, const YCPTerm & propertyTerm );
     static YCPValue tryGetTableItem			( YWidget * widget, const YCPTerm & propertyTerm );
+    static YCPValue tryGetTableItemColumns		( YWidget * widget, const YCPTerm & propertyTerm );
     static YCPValue tryGetTableItems			( YWidget * widget );
     static YCPValue tryGetTreeItems			( YWidget * widget );
     static YCPValue tryGetItemSelectorItems		( YWidget * widget );
@@ -163,14 +220,53 @@ protected:
     static YCPValue tryGetBarGraphLabels		( YWidget * widget );
     static YCPValue tryGetTreeCurrentItem		( YWidget * widget );
     static YCPValue tryGetMenuWidgetEnabledItems        ( YWidget * widget );
+    static YCPValue tryGetSelectionWidgetItemIds	( YWidget * widget );
 
 
     /**
-     * Set the status of a widget's item to a new value.
+     * Set the status of several of a widget's items at once. 'statusMap' maps
+     * item IDs to their new status (integer or boolean). The statuses and
+     * the item IDs are all checked before anything is changed, and the
+     * widget is updated on the screen only once (if it is in a dialog).
+     *
+     * Return 'false' (without changing anything) if any status is invalid or
+     * any item was not found.
      **/
     static bool setItemStatus	( YSelectionWidget *	widget,
-				  const YCPValue &	itemId,
-				  const YCPValue &	newStatus );
+				  const YCPMap &	statusMap );
+
+    /**
+     * Return the cell in column 'column' of the table item with ID 'itemId'
+     * or 0 (and log an error) if there is no such cell.
+     **/
+    static YTableCell * findTableCell( YTable *		table,
+				       const YCPValue &	itemId,
+				       int		column );
+
+    /**
+     * Return 'true' if 'val' is a valid value for a table cell: A label
+     * (string, integer or nil) or an icon (`icon(...)).
+     **/
+    static bool isTableCellValue( const YCPValue & val );
+
+    /**
+     * Set the label (string, integer or nil) or the icon (`icon(...)) of a
+     * table cell. Throw an exception for property 'propertyName' for any
+     * other value. This does not notify the table.
+     *
+     * Return 'true' if the cell actually changed.
+     **/
+    static bool setTableCellValue( YTable *		table,
+				   YTableCell *		cell,
+				   const YCPValue &	val,
+				   const string &	propertyName );
+
+    /**
+     * Set the table cells of 'cells', a list of already checked
+     * [ itemId, column, value ] entries, and notify the table once for each
+     * cell that changed.
+     **/
+    static void setTableCells( YTable * table, const YCPList & cells );
 
     /**
      * Enable or disable a menu item.
@@ -179,6 +275,66 @@ protected:
 				  const YCPValue &	itemId,
 				  const YCPValue &	newEnabled );
 
+    /**
+     * Helper function for the ItemsDiff setters: Split an ItemsDiff map
+     *
+     *     $[ "add": [ `item(...), ... ], "remove": [ id, ... ], "update": [ `item(...), ... ] ]
+     *
+     * into its lists. All keys are optional. Throw an exception if 'val' is
+     * not such a map or if an item to add has the ID of an existing item.
+     **/
+    static void parseItemsDiff( YWidget *		widget,
+				const YCPValue &	val,
+				YCPList &		addList,
+				YCPList &		removeList,
+				YCPList &		updateList );
+
+    /**
+     * Helper function for parseItemsDiff(): Throw an exception if an item to
+     * add in an ItemsDiff has the ID of an existing item of 'widget' (that
+     * isn't removed by the same ItemsDiff) or of another item to add.
+     **/
+    static void checkAddedItemIds( YWidget *		widget,
+				   const YCPList &	addList,
+				   const YCPList &	removeList );
+
+    /**
+     * Change the cells of the existing table items that have the same IDs as
+     * the items in 'updateList' in place. This is only possible if none of
+     * them has any children and the number of cells doesn't change; if that
+     * is not the case, return 'false' without changing anything.
+     **/
+    static bool updateTableItems( YTable * table, const YCPList & updateList );
+
+    /**
+     * Apply an ItemsDiff the hard way: Get the items of 'widget' as a YCP
+     * list, remove and replace items in that list (at any tree level), append
+     * the items in 'addList' and set the result as the new items. The
+     * selected items are preserved.
+     **/
+    static bool rebuildItems( YSelectionWidget *	widget,
+			      const YCPList &		addList,
+			      const YCPList &		removeList,
+			      const YCPList &		updateList );
+
+    /**
+     * Helper function for rebuildItems(): Return a copy of 'itemList'
+     * without the items whose IDs are keys in 'removeIds' and with the items
+     * whose IDs are keys in 'updates' replaced by the corresponding values.
+     * Recurse into child item lists. 'hits' is incremented for each item
+     * that was removed or replaced.
+     **/
+    static YCPList patchItemList( const YCPList &	itemList,
+				  const YCPMap &	removeIds,
+				  const YCPMap &	updates,
+				  int &			hits );
+
+    /**
+     * Return the ID of a YCP item term (`item(`id(...), ...) or a plain
+     * string item) or YCPNull if it doesn't have one.
+     **/
+    static YCPValue itemTermId( const YCPValue & item );
+
     /**
      * Helper function for tryGetOpenItems(): Get any open tree items
      * between iterators 'begin' and 'end' and add them to the 'openItems' map.
@@ -195,6 +351,26 @@ protected:
     static void getMenuWidgetEnabledItems( YCPMap &		itemStatusMap,
                                            YItemConstIterator	begin,
                                            YItemConstIterator	end );
+
+    typedef std::unordered_map<string, YPropertyType>		PropertyTypeMap;
+    typedef std::unordered_map<const char *, PropertyTypeMap>	WidgetClassMap;
+
+    /**
+     * Cache for propertyType(): widget class -> property name -> type.
+     * The widget class names are static strings, so their addresses are
+     * unique and can be used as keys.
+     **/
+    static WidgetClassMap _propertyTypes;
+
+    typedef std::unordered_map<const char *, std::unordered_map<string, PropertySetter> > KnownSetterMap;
+    typedef std::unordered_map<const char *, std::unordered_map<string, PropertyGetter> > KnownGetterMap;
+
+    /**
+     * The handler that last succeeded for each widget class and property,
+     * so it can be called directly without trying all others first.
+     **/
+    static KnownSetterMap _knownSetters;
+    static KnownGetterMap _knownGetters;
 };
 
 
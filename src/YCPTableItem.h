@@ -34,6 +34,47 @@ you may find current contact information at www.novell.com
 #include <ycp/YCPString.h>
 #include <ycp/YCPVoid.h>
 #include <yui/YTableItem.h>
+#include "YCPItemPool.h"
+#include "YCP_util.h"
+
+
+/**
+ * Table cell class that is allocated from a pool: There are usually several
+ * cells for each table item.
+ **/
+class YCPTableCell: public YTableCell
+{
+public:
+
+    YCPTableCell( const YCPString & label,
+		  const YCPString & iconName,
+		  const YCPString & sortKey )
+	: YTableCell( label->value(), iconName->value(), sortKey->value() )
+	, _label( label )
+	{}
+
+    YCPTableCell( const YCPString & label )
+	: YTableCell( label->value() )
+	, _label( label )
+	{}
+
+    virtual ~YCPTableCell()
+	{}
+
+    /**
+     * Return this cell's label as a YCPString: The original one this cell
+     * was created with (so it is shared, not copied) unless the label was
+     * changed behind its back in the meantime. See cachedYCPString().
+     **/
+    YCPString label() const
+	{ return cachedYCPString( _label, YTableCell::label() ); }
+
+    YCP_ITEM_POOL( YCPTableCell )
+
+private:
+
+    mutable YCPString _label;
+};
 
 
 /**
@@ -62,6 +103,11 @@ public:
     virtual ~YCPTableItem()
 	{}
 
+    /**
+     * Allocate items from a pool: There are often very many of them.
+     **/
+    YCP_ITEM_POOL( YCPTableItem )
+
     /**
      * Return 'true' if this item has an ID.
      **/
@@ -82,17 +128,21 @@ public:
      * and 'sortKey' are empty).
      **/
     void addCell( const YCPString & label, const YCPString & iconName, const YCPString & sortKey )
-	{ YTableItem::addCell( label->value(), iconName->value(), sortKey->value() ); }
+	{ YTableItem::addCell( new YCPTableCell( label, iconName, sortKey ) ); }
 
     void addCell( const YCPString & label )
-	{ YTableItem::addCell( label->value() ); }
+	{ YTableItem::addCell( new YCPTableCell( label ) ); }
 
 
     /**
      * Return the label of cell no. 'index' (counting from 0 on) as a YCPString
      * or an empty YCPString if there is no cell with that index.
      **/
-    YCPString label( int index ) const { return YCPString( YTableItem::label( index ) ); }
+    YCPString label( int index ) const
+	{
+	    const YCPTableCell * ycpCell = dynamic_cast<const YCPTableCell *>( cell( index ) );
+	    return ycpCell ? ycpCell->label() : YCPString( YTableItem::label( index ) );
+	}
 
     /**
      * Return the icon of cell no. 'index' (counting from 0 on) as a YCPString
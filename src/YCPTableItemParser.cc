@@ -44,13 +44,25 @@ you may find current contact information at www.novell.com
 
 YItemCollection
 YCPTableItemParser::parseTableItemList( const YCPList & itemList )
+{
+    return parseTableItemList( itemList, 0, itemList->size() );
+}
+
+
+YItemCollection
+YCPTableItemParser::parseTableItemList( const YCPList & itemList, int begin, int end )
 {
     YItemCollection itemCollection;
-    itemCollection.reserve( itemList.size() );
+
+    if ( end > itemList->size() )
+	end = itemList->size();
+
+    if ( begin < end )
+	itemCollection.reserve( end - begin );
 
     try
     {
-	for ( int i=0; i < itemList->size(); i++ )
+	for ( int i=begin; i < end; i++ )
 	{
 	    YCPValue itemTerm = itemList->value(i);
 
@@ -70,15 +82,7 @@ YCPTableItemParser::parseTableItemList( const YCPList & itemList )
     {
 	// Delete all items created so far
 
-	YItemIterator it = itemCollection.begin();
-
-	while ( it != itemCollection.end() )
-	{
-	    YItem * item = *it;
-	    ++it;
-	    delete item;
-	}
-
+	deleteItems( itemCollection );
 	throw;
     }
 
@@ -114,64 +118,78 @@ YCPTableItemParser::parseTableItem( const YCPTerm & itemTerm )
 	    y2debug( "Parsing term arg #%d: %s", i, arg->toString().c_str() );
 #endif
 
-	    if ( arg->isTerm() )			// `id(), `cell()
+	    // Dispatch on the value type only once: This is called for each
+	    // cell of each item, i.e. very often for large tables.
+
+	    switch ( arg->valuetype() )
 	    {
-		YCPTerm term = arg->asTerm();
-
-		if ( term->name() == YUISymbol_id	// `id(...)
-		     && term->size() == 1
-		     && ! item->hasId() )		// and don't have an ID yet
-		{
-		    item->setId( term->value(0) );
-		}
-		else if ( term->name() == YUISymbol_cell ) // `cell(...)
-		{
-		    parseTableCell( item, term );
-		}
-		else
-		{
+		case YT_TERM:			// `id(), `cell()
+		    {
+			YCPTerm term = arg->asTerm();
+			string	name = term->name();
+
+			if ( name == YUISymbol_id	// `id(...)
+			     && term->size() == 1
+			     && ! item->hasId() )	// and don't have an ID yet
+			{
+			    item->setId( term->value(0) );
+			}
+			else if ( name == YUISymbol_cell ) // `cell(...)
+			{
+			    parseTableCell( item, term );
+			}
+			else
+			{
+			    YUI_THROW( YCPDialogSyntaxErrorException( usage, itemTerm ) );
+			}
+		    }
+		    break;
+
+		case YT_STRING:			// label (the user-visible text)
+		    item->addCell( arg->asString() );
+		    break;
+
+		case YT_INTEGER:		// integer label (for backwards compatibility)
+		    item->addCell( arg->toString() );
+		    break;
+
+		case YT_VOID:
+		    item->addCell( YCPString("") );
+		    break;
+
+		case YT_LIST:			// child items list
+
+		    // A children list should be the next-to-last or the last
+		    // argument of the term, but it doesn't really matter where, so
+		    // let's just allow it anywhere. It is still best practice to
+		    // specifiy it at the end of the term, and better yet, it
+		    // should be followed by one of :open or :closed.
+
+		    deleteItems( children );	// in case there is more than one
+		    children = parseTableItemList( arg->asList() );
+		    break;
+
+		case YT_SYMBOL:			// :open  or  :closed
+		    {
+			string symbol = arg->asSymbol()->symbol();
+
+			if ( symbol != YUISymbol_open && symbol != YUISymbol_closed )
+			    YUI_THROW( YCPDialogSyntaxErrorException( usage, itemTerm ) );
+
+			// This is a lot less strict than it could be, and this is
+			// intentional:
+			//
+			// An application may specify :open or :closed anywhere in the
+			// term, no matter if a children list was already specifed or
+			// if there is one at all. If there are no children, setting
+			// the item to open or closed does not do any harm.
+
+			item->setOpen( symbol == YUISymbol_open );
+		    }
+		    break;
+
+		default:
 		    YUI_THROW( YCPDialogSyntaxErrorException( usage, itemTerm ) );
-		}
-	    }
-	    else if ( arg->isString() )		// label (the user-visible text)
-	    {
-		item->addCell( arg->asString() );
-	    }
-	    else if ( arg->isInteger() )	// integer label (for backwards compatibility)
-	    {
-		item->addCell( arg->toString() );
-	    }
-	    else if ( arg->isVoid() )
-	    {
-		item->addCell( YCPString("") );
-	    }
-            else if ( arg->isList() )           // child items list
-            {
-                // A children list should be the next-to-last or the last
-                // argument of the term, but it doesn't really matter where, so
-                // let's just allow it anywhere. It is still best practice to
-                // specifiy it at the end of the term, and better yet, it
-                // should be followed by one of :open or :closed.
-
-                children = parseTableItemList( arg->asList() );
-            }
-            else if ( arg->isSymbol()    &&     // :open  or  :closed
-                      ( arg->asSymbol()->symbol() == YUISymbol_open   ||
-                        arg->asSymbol()->symbol() == YUISymbol_closed    ) )
-            {
-                // This is a lot less strict than it could be, and this is
-                // intentional:
-                //
-                // An application may specify :open or :closed anywhere in the
-                // term, no matter if a children list was already specifed or
-                // if there is one at all. If there are no children, setting
-                // the item to open or closed does not do any harm.
-
-                item->setOpen( arg->asSymbol()->symbol() == YUISymbol_open );
-            }
-	    else
-	    {
-		YUI_THROW( YCPDialogSyntaxErrorException( usage, itemTerm ) );
 	    }
 	}
 
@@ -190,6 +208,7 @@ YCPTableItemParser::parseTableItem( const YCPTerm & itemTerm )
     }
     catch ( YUIException & exception )
     {
+	deleteItems( children );
 	delete item;
 	throw;
     }
@@ -270,3 +289,13 @@ YCPTableItemParser::parseTableCell( YCPTableItem * parent, const YCPTerm & cellT
 
     parent->addCell( label, iconName, sortKey );
 }
+
+
+void
+YCPTableItemParser::deleteItems( YItemCollection & items )
+{
+    for ( YItemIterator it = items.begin(); it != items.end(); ++it )
+	delete *it;
+
+    items.clear();
+}
@@ -69,6 +69,17 @@ public:
      **/
     static YItemCollection parseTableItemList( const YCPList & ycpItemList );
 
+    /**
+     * Parse only the items with indices 'begin' (inclusive) to 'end'
+     * (exclusive) of a table item list. This is used to parse very long
+     * lists chunk by chunk.
+     *
+     * This function throws exceptions if there are syntax errors.
+     **/
+    static YItemCollection parseTableItemList( const YCPList &	ycpItemList,
+					       int		begin,
+					       int		end );
+
 
 protected:
 
@@ -108,6 +119,11 @@ protected:
      *         `cell( "Label", `icon( "icon.png" ) )
      **/
     static void parseTableCell( YCPTableItem * parent, const YCPTerm & cellTerm );
+
+    /**
+     * Delete all items in 'items' and clear the collection.
+     **/
+    static void deleteItems( YItemCollection & items );
 };
 
 
@@ -26,13 +26,16 @@ you may find current contact information at www.novell.com
 
 /-*/
 
+#include <ycp/YCPSymbol.h>
 #include <ycp/YCPVoid.h>
 #include "YCPTableItemWriter.h"
 #include <yui/YUISymbols.h>
 
 
 YCPList
-YCPTableItemWriter::itemList( YItemConstIterator begin, YItemConstIterator end )
+YCPTableItemWriter::itemList( YItemConstIterator	begin,
+			      YItemConstIterator	end,
+			      bool			complete )
 {
     YCPList itemList;
 
@@ -42,7 +45,7 @@ YCPTableItemWriter::itemList( YItemConstIterator begin, YItemConstIterator end )
 
 	if ( item )
 	{
-	    itemList->add( itemTerm( item ) );
+	    itemList->add( itemTerm( item, complete ) );
 	}
     }
 
@@ -51,7 +54,7 @@ YCPTableItemWriter::itemList( YItemConstIterator begin, YItemConstIterator end )
 
 
 YCPValue
-YCPTableItemWriter::itemTerm( const YTableItem * item )
+YCPTableItemWriter::itemTerm( const YTableItem * item, bool complete )
 {
     if ( ! item )
 	return YCPVoid();
@@ -68,32 +71,110 @@ YCPTableItemWriter::itemTerm( const YTableItem * item )
     }
 
     for ( YTableCellConstIterator it = item->cellsBegin(); it != item->cellsEnd(); ++it )
-	itemTerm->add( cellValue( *it ) );
+	itemTerm->add( cellValue( *it, complete ) );
+
+    if ( complete && item->hasChildren() )		// child items list
+    {
+	itemTerm->add( itemList( item->childrenBegin(), item->childrenEnd(), complete ) );
+	itemTerm->add( YCPSymbol( item->isOpen() ? YUISymbol_open : YUISymbol_closed ) );
+    }
 
     return itemTerm;
 }
 
 
+YCPList
+YCPTableItemWriter::itemList( YItemConstIterator	begin,
+			      YItemConstIterator	end,
+			      const std::vector<int> &	columns,
+			      bool			complete )
+{
+    YCPList itemList;
+
+    for ( YItemConstIterator it = begin; it != end; ++it )
+    {
+	const YTableItem * item = dynamic_cast<const YTableItem *> (*it);
+
+	if ( item )
+	{
+	    itemList->add( itemTerm( item, columns, complete ) );
+	}
+    }
+
+    return itemList;
+}
+
+
 YCPValue
-YCPTableItemWriter::cellValue( const YTableCell * cell )
+YCPTableItemWriter::itemTerm( const YTableItem *		item,
+			      const std::vector<int> &	columns,
+			      bool			complete )
 {
-    if ( ! cell )
+    if ( ! item )
 	return YCPVoid();
 
-    if ( cell->hasIconName() )
+    YCPTerm itemTerm( YUISymbol_item );	// `item()
+
+    const YCPTableItem * ycpItem = dynamic_cast<const YCPTableItem *> (item);
+
+    if ( ycpItem && ycpItem->hasId() )
     {
-	YCPTerm iconTerm( YUISymbol_icon );		// `icon()
-	iconTerm->add( YCPString( cell->iconName() ) );	// `icon("myicon.png")
+	YCPTerm idTerm( YUISymbol_id );	// `id()
+	idTerm->add( ycpItem->id() );
+	itemTerm->add( idTerm );
+    }
+
+    for ( size_t i=0; i < columns.size(); i++ )
+	itemTerm->add( cellValue( item->cell( columns[i] ), complete ) );	// nil for nonexistent cells
+
+    if ( complete && item->hasChildren() )		// child items list
+    {
+	itemTerm->add( itemList( item->childrenBegin(), item->childrenEnd(), columns, complete ) );
+	itemTerm->add( YCPSymbol( item->isOpen() ? YUISymbol_open : YUISymbol_closed ) );
+    }
 
+    return itemTerm;
+}
+
+
+YCPValue
+YCPTableItemWriter::cellValue( const YTableCell * cell, bool complete )
+{
+    if ( ! cell )
+	return YCPVoid();
+
+    // Use the label the cell was created with if possible rather than a copy
+
+    const YCPTableCell * ycpCell = dynamic_cast<const YCPTableCell *>( cell );
+    YCPString label = ycpCell ? ycpCell->label() : YCPString( cell->label() );
+
+    bool sortKey = complete && cell->hasSortKey();
+
+    if ( cell->hasIconName() || sortKey )
+    {
 	YCPTerm cellTerm( YUISymbol_cell );		// `cell()
-	cellTerm->add( iconTerm );			// `cell(`icon("myicon.png"))
-	cellTerm->add( YCPString( cell->label() ) );	// `cell(`icon("myicon.png"), "mylabel")
+
+	if ( cell->hasIconName() )
+	{
+	    YCPTerm iconTerm( YUISymbol_icon );		// `icon()
+	    iconTerm->add( YCPString( cell->iconName() ) );	// `icon("myicon.png")
+	    cellTerm->add( iconTerm );			// `cell(`icon("myicon.png"))
+	}
+
+	if ( sortKey )
+	{
+	    YCPTerm sortKeyTerm( YUISymbol_sortKey );	// `sortKey()
+	    sortKeyTerm->add( YCPString( cell->sortKey() ) );
+	    cellTerm->add( sortKeyTerm );
+	}
+
+	cellTerm->add( label );				// `cell(`icon("myicon.png"), "mylabel")
 
 	return cellTerm;
     }
-    else // no icon
+    else // no icon, no sort key
     {
-	return YCPString( cell->label() );		// "mylabel"
+	return label;					// "mylabel"
     }
 }
 
@@ -43,6 +43,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include <ycp/YCPList.h>
 #include <ycp/YCPTerm.h>
 #include <ycp/YCPValue.h>
+#include <vector>
 
 #include "YCPTableItem.h"
 
@@ -68,8 +69,15 @@ public:
      * never returned here since if no ID is explicitly specified, the label
      * itself is used as the ID, so every item always has an ID, so the `id()
      * term and thus the `item() term have to be used.
+     *
+     * If 'complete' is true, sort keys and child items are returned as well
+     * (see itemTerm()), so the list can be parsed again without losing
+     * anything. QueryWidget( `id(...), `Items ) doesn't do that for
+     * compatibility; ItemsDiff needs it.
      **/
-    static YCPList itemList( YItemConstIterator begin, YItemConstIterator end );
+    static YCPList itemList( YItemConstIterator	begin,
+			     YItemConstIterator	end,
+			     bool		complete = false );
 
 
     /**
@@ -80,18 +88,49 @@ public:
      *         `item(`id(`myID3 ), "Label1", `cell(`icon( "icon2.png" ), "Label2" ), "Label3" )
      *         `item(`id(`myID4 ), "Label1", `cell( "Label2", `icon( "icon2.png")), "Label3" )
      *
-     * `cell() will be created only if a cell has an icon.
+     * `cell() will be created only if a cell has an icon (or, if 'complete'
+     * is true, a sort key). If 'complete' is true, child items are added as
+     * a nested list, followed by `open or `closed.
+     **/
+    static YCPValue itemTerm( const YTableItem * item, bool complete = false );
+
+    /**
+     * Create a YCPList from a table item collection like itemList() above,
+     * but only with the cells of the columns in 'columns' (in that order):
+     *
+     *     [
+     *         `item(`id(`myID1 ), "Label1", "Label3" ),
+     *         `item(`id(`myID2 ), "Label1", nil )
+     *     ]
+     *
+     * A column that an item doesn't have is returned as nil, so the
+     * position of each cell in the item term is always the same. Apart from
+     * that, this is the same as the other itemList() with the other cells
+     * removed, also for 'complete'.
+     **/
+    static YCPList itemList( YItemConstIterator		begin,
+			     YItemConstIterator		end,
+			     const std::vector<int> &	columns,
+			     bool			complete = false );
+
+    /**
+     * Create a YCPTerm for one table item with only the cells of the columns
+     * in 'columns'. See itemList() above.
      **/
-    static YCPValue itemTerm( const YTableItem * item );
+    static YCPValue itemTerm( const YTableItem *	item,
+			      const std::vector<int> &	columns,
+			      bool			complete = false );
 
     /**
      * Create a YCPValue for one table cell: A YCPString if a cell has only a
-     * label and no icon, and a YCPTerm with `cell() otherwise.
+     * label and no icon, and a YCPTerm with `cell() otherwise. If 'complete'
+     * is true, a sort key is returned, too.
      *
      *		"Label"
      *         `cell( `icon( "icon.png"), "Label" )
+     *         `cell( `sortKey( "sda001" ), "Label" )
      **/
-    static YCPValue cellValue( const YTableCell * cell );
+    static YCPValue cellValue( const YTableCell * cell, bool complete = false );
 };
 
 
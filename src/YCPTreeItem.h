@@ -32,6 +32,8 @@ you may find current contact information at www.novell.com
 #include <ycp/YCPValue.h>
 #include <ycp/YCPString.h>
 #include <yui/YTreeItem.h>
+#include "YCPItemPool.h"
+#include "YCP_util.h"
 
 
 /**
@@ -53,6 +55,8 @@ public:
 		 bool			isOpen )
 	: YTreeItem( label->value(), isOpen )
 	, _id( id )
+	, _label( label )
+	, _lazy( false )
 	{}
 
     YCPTreeItem( const YCPString & 	label,
@@ -61,6 +65,8 @@ public:
 		 bool			isOpen )
 	: YTreeItem( label->value(), iconName->value(), isOpen )
 	, _id( id )
+	, _label( label )
+	, _lazy( false )
 	{}
 
     YCPTreeItem( YCPTreeItem *		parent,
@@ -69,6 +75,8 @@ public:
 		 bool			isOpen )
 	: YTreeItem( parent, label->value(), isOpen )
 	, _id( id )
+	, _label( label )
+	, _lazy( false )
 	{}
 
     YCPTreeItem( YCPTreeItem *		parent,
@@ -78,6 +86,8 @@ public:
 		 bool			isOpen )
 	: YTreeItem( parent, label->value(), iconName->value(), isOpen )
 	, _id( id )
+	, _label( label )
+	, _lazy( false )
 	{}
 
     /**
@@ -86,6 +96,11 @@ public:
     virtual ~YCPTreeItem()
 	{}
 
+    /**
+     * Allocate items from a pool: There are often very many of them.
+     **/
+    YCP_ITEM_POOL( YCPTreeItem )
+
     /**
      * Return 'true' if this item has an ID.
      **/
@@ -102,15 +117,18 @@ public:
     void setId( const YCPValue & newId ) { _id = newId; }
 
     /**
-     * Return this item's label as a YCPString.
+     * Return this item's label as a YCPString: The original one this item
+     * was created with (so it is shared, not copied) unless the label was
+     * changed behind its back in the meantime. See cachedYCPString().
      **/
-    YCPString label() const { return YCPString( YTreeItem::label() ); }
+    YCPString label() const
+	{ return cachedYCPString( _label, YTreeItem::label() ); }
 
     /**
      * Set this item's label with a YCPString.
      **/
     void setLabel( const YCPString & newLabel )
-	{ YTreeItem::setLabel( newLabel->value() ); }
+	{ YTreeItem::setLabel( newLabel->value() ); _label = newLabel; }
 
     /**
      * Return this item's icon name as a YCPString.
@@ -123,10 +141,24 @@ public:
     void setIconName( const YCPString & newIconName )
 	{ YTreeItem::setIconName( newIconName->value() ); }
 
+    /**
+     * Return 'true' if the children of this item are not known yet: It has
+     * only a placeholder child, and the application supplies the real
+     * children only when the user opens this item. See YCPLazyTreeItems.
+     **/
+    bool isLazy() const { return _lazy; }
+
+    /**
+     * Set the "lazy" flag.
+     **/
+    void setLazy( bool lazy ) { _lazy = lazy; }
+
 
 private:
 
-    YCPValue _id;
+    YCPValue		_id;
+    mutable YCPString	_label;
+    bool		_lazy;
 };
 
 
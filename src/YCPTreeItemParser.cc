@@ -29,17 +29,28 @@ you may find current contact information at www.novell.com
 
 #include <ycp/YCPTerm.h>
 #include <ycp/YCPBoolean.h>
+#include <ycp/YCPSymbol.h>
 
 #define y2log_component "ui"
 #include <ycp/y2log.h>
 
 #include "YCPTreeItemParser.h"
+#include "YCPLazyTreeItems.h"
 #include "YCP_UI_Exception.h"
 #include <yui/YUISymbols.h>
 
+#include <string>
+#include <vector>
+
+using std::vector;
+
 #define VERBOSE_PARSER	0
 
 
+int YCPTreeItemParser::_maxDepth = YCPTreeItemParser_DefaultMaxDepth;
+int YCPTreeItemParser::_maxItems = YCPTreeItemParser_DefaultMaxItems;
+
+
 YItemCollection
 YCPTreeItemParser::parseTreeItemList( const YCPList & itemList )
 {
@@ -48,12 +59,9 @@ YCPTreeItemParser::parseTreeItemList( const YCPList & itemList )
 
     try
     {
-	for ( int i=0; i < itemList->size(); i++ )
-	{
-	    YCPTreeItem * item = parseTreeItem( 0, // parent item
-						itemList->value(i) );
-	    itemCollection.push_back( item );
-	}
+	parseTreeItems( 0, // parent item
+			itemList,
+			itemCollection );
     }
     catch ( YUIException & exception )
     {
@@ -61,7 +69,7 @@ YCPTreeItemParser::parseTreeItemList( const YCPList & itemList )
 
 	while ( it != itemCollection.end() )
 	{
-	    // Delete all items created so far
+	    // Delete all items created so far (with all their children)
 	    
 	    YItem * item = *it;
 	    ++it;
@@ -82,6 +90,107 @@ YCPTreeItemParser::parseTreeItemList( const YCPList & itemList )
 
 YCPTreeItem *
 YCPTreeItemParser::parseTreeItem( YCPTreeItem * parent, const YCPValue & rawItem )
+{
+    YCPList subItemList = YCPNull();
+    YCPTreeItem * item = parseTreeItem( parent, rawItem, subItemList );
+
+    if ( ! subItemList.isNull() )
+    {
+	YItemCollection unused; // only toplevel items (without parent) go there
+
+	try
+	{
+	    parseTreeItems( item, subItemList, unused );
+	}
+	catch ( YUIException & exception )
+	{
+	    if ( ! parent )	// otherwise the parent owns the item
+		delete item;
+
+	    throw;
+	}
+    }
+
+    return item;
+}
+
+
+void
+YCPTreeItemParser::setLimits( int maxDepth, int maxItems )
+{
+    _maxDepth = maxDepth;
+    _maxItems = maxItems;
+}
+
+
+void
+YCPTreeItemParser::parseTreeItems( YCPTreeItem *	parent,
+				   const YCPList &	itemList,
+				   YItemCollection &	toplevelItems )
+{
+    // Iterative depth-first traversal with an explicit stack: Trees may be
+    // very deep, and the UI thread may have only a small stack.
+
+    struct Level
+    {
+	Level( YCPTreeItem * p, const YCPList & l )
+	    : parent( p ), items( l ), next( 0 ) {}
+
+	YCPTreeItem *	parent;
+	YCPList		items;
+	int		next;
+    };
+
+    int depth = 1;
+
+    for ( YTreeItem * p = parent; p; p = p->parent() )
+	++depth;
+
+    int itemCount = 0;
+    vector<Level> stack;
+    stack.push_back( Level( parent, itemList ) );
+
+    while ( ! stack.empty() )
+    {
+	Level & level = stack.back();
+
+	if ( level.next >= level.items->size() )
+	{
+	    stack.pop_back();
+	    continue;
+	}
+
+	YCPValue      rawItem = level.items->value( level.next++ );
+	YCPList	      subItemList = YCPNull();
+	YCPTreeItem * item = parseTreeItem( level.parent, rawItem, subItemList );
+
+	if ( ! level.parent )
+	    toplevelItems.push_back( item );
+
+	if ( _maxItems > 0 && ++itemCount > _maxItems )
+	{
+	    YUI_THROW( YCPDialogSyntaxErrorException( "Too many tree items (limit: "
+						      + std::to_string( _maxItems ) + ")" ) );
+	}
+
+	if ( ! subItemList.isNull() && subItemList->size() > 0 )
+	{
+	    if ( _maxDepth > 0 && depth + (int) stack.size() > _maxDepth )
+	    {
+		YUI_THROW( YCPDialogSyntaxErrorException( "Tree items nested too deeply (limit: "
+							  + std::to_string( _maxDepth ) + " levels)" ) );
+	    }
+
+	    stack.push_back( Level( item, subItemList ) ); // invalidates 'level'
+	}
+    }
+}
+
+
+YCPTreeItem *
+YCPTreeItemParser::parseTreeItem( YCPTreeItem *	parent,
+				  const YCPValue &	rawItem,
+				  YCPList &		subItemList )
 {
     YCPTreeItem * item = 0;
 
@@ -102,7 +211,7 @@ YCPTreeItemParser::parseTreeItem( YCPTreeItem * parent, const YCPValue & rawItem
 	if ( rawItem->isTerm() &&
 	     rawItem->asTerm()->name() == YUISymbol_item )	// `item(...)
 	{
-	    item = parseTreeItem( parent, rawItem->asTerm() );
+	    item = parseTreeItem( parent, rawItem->asTerm(), subItemList );
 	}
 	else	// not `item(...)
 	{
@@ -115,16 +224,20 @@ YCPTreeItemParser::parseTreeItem( YCPTreeItem * parent, const YCPValue & rawItem
 
 
 YCPTreeItem *
-YCPTreeItemParser::parseTreeItem( YCPTreeItem * parent, const YCPTerm & itemTerm )
+YCPTreeItemParser::parseTreeItem( YCPTreeItem *	parent,
+				  const YCPTerm &	itemTerm,
+				  YCPList &		subItemList )
 {
     YCPValue	id	 	= YCPNull();
     YCPString	iconName 	= YCPNull();
     YCPString	label	 	= YCPNull();
     YCPBoolean 	isOpen	 	= YCPNull();
-    YCPList	subItemList	= YCPNull();
+    bool	lazy		= false;
+
+    subItemList = YCPNull();
     
     const char * usage =
-	"Expected: `item(`id(`myID), `icon(\"MyIcon.png\"), \"MyItemText\", boolean isOpen, list subItemList )";
+	"Expected: `item(`id(`myID), `icon(\"MyIcon.png\"), \"MyItemText\", boolean isOpen, list subItemList | `lazy )";
     
 #if VERBOSE_PARSER
     y2debug( "Parsing: %s", itemTerm->toString().c_str() );
@@ -176,6 +289,12 @@ YCPTreeItemParser::parseTreeItem( YCPTreeItem * parent, const YCPTerm & itemTerm
 	{
 	    subItemList = arg->asList();
 	}
+	else if ( arg->isSymbol()		// `lazy: children are supplied later
+		  && arg->asSymbol()->symbol() == YCPSymbol_lazy
+		  && ! lazy )
+	{
+	    lazy = true;
+	}
 	else
 	{
 	    YUI_THROW( YCPDialogSyntaxErrorException( usage, itemTerm ) );
@@ -197,13 +316,10 @@ YCPTreeItemParser::parseTreeItem( YCPTreeItem * parent, const YCPTerm & itemTerm
     YCPTreeItem * item = new YCPTreeItem( parent, label, id, iconName, isOpen->value() );
     YUI_CHECK_NEW( item );
 
-    if ( ! subItemList.isNull() )
-    {
-	for ( int i=0; i < subItemList->size(); i++ )
-	{
-	    parseTreeItem( item, subItemList->value(i) );
-	}
-    }
+    // The sub items are parsed by the caller. A sub item list wins over `lazy.
+
+    if ( lazy && subItemList.isNull() )
+	YCPLazyTreeItems::addPlaceholder( item );
 
     return item;
 }
@@ -33,6 +33,9 @@ you may find current contact information at www.novell.com
 #include <ycp/YCPTerm.h>
 #include "YCPTreeItem.h"
 
+#define YCPTreeItemParser_DefaultMaxDepth	1000
+#define YCPTreeItemParser_DefaultMaxItems	1000000
+
 
 /**
  * Parser for tree item lists
@@ -48,9 +51,13 @@ public:
      *         `item(`id( `myID1 ), "Label1" ),
      *         `item(`id( `myID2 ), `icon( "icon2.png"), "Label2", true ),
      *         `item(`id( `myID3 ), `icon( "icon3.png"), "Label3", true, [ subItemList ] ),
-     *         "Label4"
+     *         `item(`id( `myID4 ), "Label4", `lazy ),
+     *         "Label5"
      *     ]
      *
+     * `lazy means the children of that item are supplied later when the user
+     * opens it (see YCPLazyTreeItems).
+     *
      * Return a list of newly created YItem-derived objects.
      *
      * This function throws exceptions if there are syntax errors.
@@ -65,23 +72,66 @@ public:
      **/
     static YCPTreeItem * parseTreeItem( YCPTreeItem * parent, const YCPValue & item );
 
+    /**
+     * Set the maximum nesting depth and the maximum number of items of one
+     * tree item list. Exceeding either throws an exception. 0 means
+     * "unlimited".
+     *
+     * The defaults are YCPTreeItemParser_DefaultMaxDepth and
+     * YCPTreeItemParser_DefaultMaxItems.
+     **/
+    static void setLimits( int maxDepth, int maxItems );
+
+    static int maxDepth() { return _maxDepth; }
+    static int maxItems() { return _maxItems; }
+
 protected:
 
+    /**
+     * Parse the items of 'itemList' and all their sub items as children of
+     * 'parent'. Add items without a parent to 'toplevelItems'.
+     *
+     * This does not recurse, so very deep trees don't exhaust the stack.
+     *
+     * This function throws exceptions if there are syntax errors or if the
+     * limits (see setLimits()) are exceeded.
+     **/
+    static void parseTreeItems( YCPTreeItem *		parent,
+				const YCPList &		itemList,
+				YItemCollection &	toplevelItems );
+
+    /**
+     * Parse one item without its sub items and create a YCPTreeItem from it.
+     * Return the sub item list (or YCPNull) in 'subItemList'.
+     *
+     * This function throws exceptions if there are syntax errors.
+     **/
+    static YCPTreeItem * parseTreeItem( YCPTreeItem *		parent,
+					const YCPValue &	item,
+					YCPList &		subItemList );
+
     /**
      * Parse an item term:
      *
      *         `item(`id( `myID1 ), "Label1" )
      *         `item(`id( `myID2 ), `icon( "icon2.png"), "Label2", true )
      *         `item(`id( `myID3 ), `icon( "icon3.png"), "Label3", true, [ subItemList ] )
-     *         "Label4"
+     *         `item(`id( `myID4 ), "Label4", `lazy )
+     *         "Label5"
      *
-     * Everything except the label is optional.
+     * Everything except the label is optional. The sub item list is not
+     * parsed here, it is returned in 'subItemList'.
      *
      * This function throws exceptions if there are syntax errors.
      **/
-    static YCPTreeItem * parseTreeItem( YCPTreeItem * parent, const YCPTerm & itemTerm );
+    static YCPTreeItem * parseTreeItem( YCPTreeItem *	parent,
+					const YCPTerm &	itemTerm,
+					YCPList &	subItemList );
+
+private:
 
-    
+    static int _maxDepth;
+    static int _maxItems;
 };
 
 
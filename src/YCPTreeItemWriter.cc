@@ -28,7 +28,9 @@ you may find current contact information at www.novell.com
 
 #include <ycp/YCPVoid.h>
 #include <ycp/YCPBoolean.h>
+#include <ycp/YCPSymbol.h>
 #include "YCPTreeItemWriter.h"
+#include "YCPLazyTreeItems.h"
 #include <yui/YUISymbols.h>
 
 
@@ -75,12 +77,17 @@ YCPTreeItemWriter::itemTerm( const YTreeItem * item )
 	itemTerm->add( iconTerm );
     }
 
-    itemTerm->add( YCPString( item->label() ) );	// label
+    if ( ycpItem )					// label
+	itemTerm->add( ycpItem->label() );		// (shared with the item, not copied)
+    else
+	itemTerm->add( YCPString( item->label() ) );
 
     if ( item->isOpen() )				// isOpen
 	itemTerm->add( YCPBoolean( item->isOpen() ) );
 
-    if ( item->hasChildren() )				// subItemList
+    if ( ycpItem && ycpItem->isLazy() )		// `lazy instead of the placeholder child
+	itemTerm->add( YCPSymbol( YCPSymbol_lazy ) );
+    else if ( item->hasChildren() )			// subItemList
 	itemTerm->add( itemList( item->childrenBegin(), item->childrenEnd() ) );
 
     return itemTerm;
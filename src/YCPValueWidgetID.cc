@@ -34,6 +34,8 @@ you may find current contact information at www.novell.com
 
 YCPValueWidgetID::YCPValueWidgetID( const YCPValue & val )
     : _value( val )
+    , _valueType( valueType( val ) )
+    , _hash( hashValue( val ) )
 {
 }
 
@@ -45,23 +47,30 @@ YCPValueWidgetID::isEqual( YWidgetID * otherID ) const
 	dynamic_cast<YCPValueWidgetID *> (otherID);
 
     if ( otherYCPValueID )
+    {
+	// Cheap checks first; only compare the values if they might be equal
+
+	if ( _hash	!= otherYCPValueID->_hash ||
+	     _valueType != otherYCPValueID->_valueType )
+	{
+	    return false;
+	}
+
 	return _value->equal( otherYCPValueID->value() );
+    }
 
-    if ( _value->isString() || _value->isSymbol() )
+    if ( _valueType == StringValue || _valueType == SymbolValue )
     {
 	YStringWidgetID * otherStringID =
 	    dynamic_cast<YStringWidgetID *> (otherID);
 
         if ( otherStringID )
         {
-            if ( _value->isString() )
-            {
-                return _value->asString()->value() == otherStringID->value();
-            }
-            else // _value->isSymbol()
-            {
-                return _value->asSymbol()->symbol() == otherStringID->value();
-            }
+	    const char * text = _valueType == StringValue ?
+		_value->asString()->value_cstr() :
+		_value->asSymbol()->symbol_cstr();
+
+	    return otherStringID->valueConstRef() == text;
         }
     }
 
@@ -73,7 +82,7 @@ string
 YCPValueWidgetID::toString() const
 {
     // If value is Symbol - get symbol
-    if ( _value->isSymbol() ) return _value->asSymbol()->symbol();
+    if ( _valueType == SymbolValue ) return _value->asSymbol()->symbol();
     // Else return as string
     return _value->toString();
 }
@@ -84,3 +93,42 @@ YCPValueWidgetID::value() const
 {
     return _value;
 }
+
+
+uint64_t
+YCPValueWidgetID::hashValue( const YCPValue & val )
+{
+    switch ( valueType( val ) )
+    {
+	case SymbolValue:	return hashString( val->asSymbol()->symbol_cstr() );
+	case StringValue:	return hashString( val->asString()->value_cstr() );
+	default:		return hashString( val->toString().c_str() );
+    }
+}
+
+
+uint64_t
+YCPValueWidgetID::hashString( const char * str )
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    while ( *str )
+    {
+	hash ^= (unsigned char) *str++;
+	hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+
+YCPValueWidgetID::ValueType
+YCPValueWidgetID::valueType( const YCPValue & val )
+{
+    if ( val->isSymbol()  ) return SymbolValue;
+    if ( val->isString()  ) return StringValue;
+    if ( val->isInteger() ) return IntegerValue;
+    if ( val->isTerm()    ) return TermValue;
+
+    return OtherValue;
+}
@@ -30,6 +30,7 @@ you may find current contact information at www.novell.com
 #ifndef YCPValueWidgetID_h
 #define YCPValueWidgetID_h
 
+#include <stdint.h>
 #include <yui/YWidgetID.h>
 #include <ycp/YCPValue.h>
 
@@ -43,6 +44,18 @@ class YCPValueWidgetID: public YWidgetID
 {
 public:
 
+    /**
+     * Type of the ID value. IDs with different types are never equal.
+     **/
+    enum ValueType
+    {
+	SymbolValue,
+	StringValue,
+	IntegerValue,
+	TermValue,
+	OtherValue
+    };
+
     /**
      * Constructor.
      **/
@@ -68,9 +81,39 @@ public:
      **/
     YCPValue value() const;
 
+    /**
+     * Return the type of the ID value.
+     **/
+    ValueType valueType() const { return _valueType; }
+
+    /**
+     * Return the hash of the ID value. This is the same as hashValue( value() ).
+     **/
+    uint64_t hash() const { return _hash; }
+
+    /**
+     * Return the hash of an ID value: The hash of the plain text for symbols
+     * and strings (so they hash the same as a YStringWidgetID with that
+     * text), the hash of the value's string representation for everything
+     * else.
+     **/
+    static uint64_t hashValue( const YCPValue & value );
+
+    /**
+     * Return the hash of a string (64 bit FNV-1a).
+     **/
+    static uint64_t hashString( const char * str );
+
+    /**
+     * Return the type of an ID value.
+     **/
+    static ValueType valueType( const YCPValue & value );
+
 private:
-    
-    YCPValue _value;
+
+    YCPValue	_value;
+    ValueType	_valueType;
+    uint64_t	_hash;
 };
 
 
@@ -0,0 +1,242 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPWidgetIdIndex.cc
+
+		Per-dialog index of widget IDs for fast widget lookup.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#include <algorithm>
+
+#define YUILogComponent "ui"
+#include <yui/YUILog.h>
+
+#include <yui/YWidget.h>
+#include <yui/YWidgetID.h>
+#include <yui/YDialog.h>
+
+#include "YCPWidgetIdIndex.h"
+#include "YCPValueWidgetID.h"
+
+
+YCPWidgetIdIndex::DialogMap YCPWidgetIdIndex::_dialogs;
+
+
+YWidget *
+YCPWidgetIdIndex::findWidget( YDialog * dialog, const YCPValue & idVal )
+{
+    if ( ! dialog )
+	return 0;
+
+    YCPValueWidgetID id( idVal );
+
+    IdMap & idMap = index( dialog );
+    IdMap::const_iterator it = idMap.find( id.hash() );
+
+    if ( it == idMap.end() )
+	return 0;
+
+    const vector<YWidget *> & candidates = it->second;
+
+    // There is usually only one candidate; more than one only for IDs with
+    // the same text, but of different types, e.g. `foo and "foo", or for
+    // hash collisions.
+
+    for ( size_t i=0; i < candidates.size(); i++ )
+    {
+	if ( verify( candidates[i], &id ) )
+	    return candidates[i];
+    }
+
+    return 0;
+}
+
+
+void
+YCPWidgetIdIndex::addWidget( YDialog * dialog, YWidget * widget )
+{
+    IdMap * idMap = existingIndex( dialog );
+
+    if ( idMap && widget )
+	add( *idMap, widget );
+}
+
+
+void
+YCPWidgetIdIndex::addSubtree( YDialog * dialog, YWidget * widget )
+{
+    IdMap * idMap = existingIndex( dialog );
+
+    if ( idMap && widget )
+	addRecursive( *idMap, widget );
+}
+
+
+void
+YCPWidgetIdIndex::removeWidget( YDialog * dialog, YWidget * widget )
+{
+    IdMap * idMap = existingIndex( dialog );
+
+    if ( idMap && widget )
+	remove( *idMap, widget );
+}
+
+
+void
+YCPWidgetIdIndex::removeChildren( YDialog * dialog, YWidget * widget )
+{
+    IdMap * idMap = existingIndex( dialog );
+
+    if ( ! idMap || ! widget )
+	return;
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	removeRecursive( *idMap, *it );
+    }
+}
+
+
+void
+YCPWidgetIdIndex::removeDialog( YDialog * dialog )
+{
+    _dialogs.erase( dialog );
+}
+
+
+uint64_t
+YCPWidgetIdIndex::key( const YWidgetID * id )
+{
+    const YCPValueWidgetID * ycpId = dynamic_cast<const YCPValueWidgetID *>( id );
+
+    if ( ycpId )
+	return ycpId->hash();
+
+    // YStringWidgetID and others: Use the plain text
+
+    return YCPValueWidgetID::hashString( id->toString().c_str() );
+}
+
+
+YCPWidgetIdIndex::IdMap *
+YCPWidgetIdIndex::existingIndex( const YDialog * dialog )
+{
+    DialogMap::iterator it = _dialogs.find( dialog );
+
+    return it == _dialogs.end() ? 0 : &( it->second );
+}
+
+
+YCPWidgetIdIndex::IdMap &
+YCPWidgetIdIndex::index( YDialog * dialog )
+{
+    IdMap * idMap = existingIndex( dialog );
+
+    if ( ! idMap )
+    {
+	idMap = &( _dialogs[ dialog ] );
+	addRecursive( *idMap, dialog );
+
+	yuiDebug() << "Created widget ID index for " << dialog
+		   << " with " << idMap->size() << " IDs" << endl;
+    }
+
+    return *idMap;
+}
+
+
+void
+YCPWidgetIdIndex::addRecursive( IdMap & idMap, YWidget * widget )
+{
+    add( idMap, widget );
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	addRecursive( idMap, *it );
+    }
+}
+
+
+void
+YCPWidgetIdIndex::removeRecursive( IdMap & idMap, YWidget * widget )
+{
+    remove( idMap, widget );
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	removeRecursive( idMap, *it );
+    }
+}
+
+
+void
+YCPWidgetIdIndex::add( IdMap & idMap, YWidget * widget )
+{
+    if ( ! widget->hasId() )
+	return;
+
+    vector<YWidget *> & candidates = idMap[ key( widget->id() ) ];
+
+    if ( std::find( candidates.begin(), candidates.end(), widget ) == candidates.end() )
+	candidates.push_back( widget );
+}
+
+
+void
+YCPWidgetIdIndex::remove( IdMap & idMap, YWidget * widget )
+{
+    if ( ! widget->hasId() )
+	return;
+
+    IdMap::iterator it = idMap.find( key( widget->id() ) );
+
+    if ( it != idMap.end() )
+    {
+	vector<YWidget *> & candidates = it->second;
+	candidates.erase( std::remove( candidates.begin(), candidates.end(), widget ),
+			  candidates.end() );
+
+	if ( candidates.empty() )
+	    idMap.erase( it );
+    }
+}
+
+
+bool
+YCPWidgetIdIndex::verify( YWidget * widget, YWidgetID * id )
+{
+    if ( ! widget->isValid() || ! widget->hasId() )
+	return false;
+
+    // Compare both ways: A YStringWidgetID doesn't know about YCPValueWidgetIDs
+
+    return id->isEqual( widget->id() ) || widget->id()->isEqual( id );
+}
@@ -0,0 +1,165 @@
+/****************************************************************************
+
+Copyright (c) 2026 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of version 2 of the GNU General Public License as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, contact Novell, Inc.
+
+To contact Novell about this file by physical or electronic mail,
+you may find current contact information at www.novell.com
+
+****************************************************************************
+
+  File:		YCPWidgetIdIndex.h
+
+		Per-dialog index of widget IDs for fast widget lookup.
+
+  Author:	Stefan Hundhammer <shundhammer@suse.de>
+
+/-*/
+
+#ifndef YCPWidgetIdIndex_h
+#define YCPWidgetIdIndex_h
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include <ycp/YCPValue.h>
+
+using std::vector;
+
+class YWidget;
+class YWidgetID;
+class YDialog;
+
+
+/**
+ * Index from widget IDs to widgets, one for each dialog.
+ *
+ * This is what makes ChangeWidget(), QueryWidget() etc. independent of the
+ * number of widgets in a dialog: Without it, each of them would have to
+ * search the complete widget tree and compare the ID of each widget.
+ *
+ * The index of a dialog is created lazily by a full widget tree walk when it
+ * is first needed. After that, widgets are added as they are created by the
+ * YCPDialogParser, and they are removed when they are deleted with
+ * ReplaceWidget(). When a dialog is closed, its index is deleted.
+ *
+ * All entries are verified upon lookup (valid widget, matching ID), so a
+ * stale entry can never result in a wrong widget being returned; the caller
+ * may then fall back to a widget tree walk.
+ **/
+class YCPWidgetIdIndex
+{
+public:
+
+    /**
+     * Find the widget with ID 'id' in the index of 'dialog'.
+     * Create that index first if necessary.
+     *
+     * Return 0 if there is no such widget in the index.
+     **/
+    static YWidget * findWidget( YDialog * dialog, const YCPValue & id );
+
+    /**
+     * Add 'widget' to the index of 'dialog' if that index already exists and
+     * if the widget has an ID. If the index doesn't exist yet, it will pick
+     * up this widget anyway when it is created.
+     **/
+    static void addWidget( YDialog * dialog, YWidget * widget );
+
+    /**
+     * Add 'widget' and all its descendants to the index of 'dialog' if that
+     * index already exists. Use this for widgets that get IDs for internal
+     * children (e.g. the Wizard).
+     **/
+    static void addSubtree( YDialog * dialog, YWidget * widget );
+
+    /**
+     * Remove 'widget' from the index of 'dialog'. Call this before changing
+     * the ID of a widget (and add it again afterwards).
+     **/
+    static void removeWidget( YDialog * dialog, YWidget * widget );
+
+    /**
+     * Remove all descendants of 'widget' (but not 'widget' itself) from the
+     * index of 'dialog'. Call this before deleting the children of a widget.
+     **/
+    static void removeChildren( YDialog * dialog, YWidget * widget );
+
+    /**
+     * Delete the index of 'dialog'. Call this when a dialog is closed or
+     * when a new dialog is created (a new dialog might get the address of
+     * one that was deleted without notice).
+     **/
+    static void removeDialog( YDialog * dialog );
+
+    /**
+     * Return the index key for a widget ID: The precomputed hash of a
+     * YCPValueWidgetID, the hash of the plain text for other IDs (like
+     * YStringWidgetID). See also YCPValueWidgetID::hashValue().
+     **/
+    static uint64_t key( const YWidgetID * id );
+
+protected:
+
+    typedef std::unordered_map<uint64_t, vector<YWidget *> >	IdMap;
+    typedef std::unordered_map<const YDialog *, IdMap>		DialogMap;
+
+    /**
+     * Return the index of 'dialog' or 0 if there is none.
+     **/
+    static IdMap * existingIndex( const YDialog * dialog );
+
+    /**
+     * Return the index of 'dialog'. Create it if there is none yet.
+     **/
+    static IdMap & index( YDialog * dialog );
+
+    /**
+     * Add 'widget' (if it has an ID) and all its descendants to 'idMap'.
+     **/
+    static void addRecursive( IdMap & idMap, YWidget * widget );
+
+    /**
+     * Remove 'widget' (if it has an ID) and all its descendants from 'idMap'.
+     **/
+    static void removeRecursive( IdMap & idMap, YWidget * widget );
+
+    /**
+     * Add 'widget' to 'idMap' if it has an ID.
+     **/
+    static void add( IdMap & idMap, YWidget * widget );
+
+    /**
+     * Remove 'widget' from 'idMap' if it has an ID.
+     **/
+    static void remove( IdMap & idMap, YWidget * widget );
+
+    /**
+     * Check if 'widget' is still a valid widget with ID 'id'.
+     **/
+    static bool verify( YWidget * widget, YWidgetID * id );
+
+private:
+
+    /**
+     * All methods are static; no instances.
+     **/
+    YCPWidgetIdIndex() {}
+
+    static DialogMap _dialogs;
+};
+
+
+#endif // YCPWidgetIdIndex_h
@@ -32,6 +32,7 @@ you may find current contact information at www.novell.com
 
 #include "YCPWizardCommandParser.h"
 #include "YCPValueWidgetID.h"
+#include "YCPWidgetIdIndex.h"
 #include <yui/YWizard.h>
 #include <yui/YPushButton.h>
 
@@ -311,7 +312,13 @@ void
 YCPWizardCommandParser::setId( YWidget * widget, const YCPValue & id )
 {
     if ( widget )
+    {
+	YDialog * dialog = widget->findDialog();
+
+	YCPWidgetIdIndex::removeWidget( dialog, widget );
 	widget->setId( new YCPValueWidgetID( id ) );
+	YCPWidgetIdIndex::addWidget( dialog, widget );
+    }
     else
 	y2error( "NULL widget" );
 }
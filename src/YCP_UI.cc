@@ -32,8 +32,12 @@ you may find current contact information at www.novell.com
 #define VERBOSE_REPLACE_WIDGET 		0
 #define VERBOSE_EVENTS			0
 
+// Check for opened lazy tree items that often while waiting for events
+#define LAZY_TREE_POLL_MILLISEC		100
+
 #include <stdio.h>
 #include <string.h>
+#include <chrono>
 
 #define y2log_component "ui"
 #include <ycp/y2log.h>	// ycperror()
@@ -49,15 +53,22 @@ you may find current contact information at www.novell.com
 #include <yui/YUIException.h>
 #include <yui/YUISymbols.h>
 #include <yui/YApplication.h>
+#include "YCPAsyncCalls.h"
+#include "YCPBatchCalls.h"
 #include "YCPDialogParser.h"
 #include "YCPErrorDialog.h"
 #include "YCPEvent.h"
+#include "YCPItemIndex.h"
+#include "YCPItemsCache.h"
+#include "YCPLazyTableItems.h"
+#include "YCPLazyTreeItems.h"
 #include "YCPItemParser.h"
 #include "YCPMacroPlayer.h"
 #include "YCPMacroRecorder.h"
 #include "YCPMenuItemParser.h"
 #include "YCPPropertyHandler.h"
 #include "YCPValueWidgetID.h"
+#include "YCPWidgetIdIndex.h"
 #include "YCPWizardCommandParser.h"
 #include "YCP_util.h"
 #include <yui/YCheckBox.h>
@@ -376,6 +387,10 @@ YCPValue YCP_UI::TimeoutUserInput( const YCPInteger & timeout )
  * Extended event handling - very much like UserInput(), but returns much more
  * detailed information about the event that occured in a map.
  *
+ * This is the only way to get the "Expanded" events of Tree widgets with
+ * lazy items: UserInput(), TimeoutUserInput() and PollInput() never return
+ * them (they couldn't be told apart from an activation of the tree).
+ *
  * @optarg timeout_millisec
  * @return map
  */
@@ -440,11 +455,19 @@ YCPValue YCP_UI::doUserInput( const char * 	builtin_name,
 
 	if ( _fakeUserInputQueue.empty() )
 	{
+	    // Opened lazy tree items can only be reported in detail: As a plain
+	    // widget ID, they would look like an activation of the tree.
+
 	    if ( wait )
-		event = dialog->waitForEvent( timeout_millisec );
+		event = waitForEvent( dialog, timeout_millisec, detailed );
 	    else
+	    {
 		event = dialog->pollEvent();
 
+		if ( ! event && detailed && YCPLazyTreeItems::hasLazyItems( dialog ) )
+		    event = YCPLazyTreeItems::openedItemEvent( dialog );
+	    }
+
 	    if ( event )
 	    {
 		YCPEvent ycpEvent( event );
@@ -497,6 +520,77 @@ YCPValue YCP_UI::doUserInput( const char * 	builtin_name,
 }
 
 
+YEvent * YCP_UI::waitForEvent( YDialog *	dialog,
+			       long		timeout_millisec,
+			       bool		lazyTreeEvents )
+{
+    // While there is no event, add the remaining items of lazy tables chunk
+    // by chunk; the UI can process events (and repaint) in between.
+    //
+    // The UIs don't send an event when the user opens a tree item, so while
+    // there are lazy tree items, check them regularly.
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool lazyTables;
+
+    while ( ( lazyTables = YCPLazyTableItems::hasPending( dialog ) ) ||
+	    ( lazyTreeEvents && YCPLazyTreeItems::hasLazyItems( dialog ) ) )
+    {
+	YEvent * event = lazyTreeEvents ? YCPLazyTreeItems::openedItemEvent( dialog ) : 0;
+
+	if ( event )
+	    return event;
+
+	if ( lazyTables )
+	{
+	    event = dialog->pollEvent();
+
+	    if ( event )
+		return event;
+
+	    YCPLazyTableItems::materializeChunk( dialog );
+	}
+	else
+	{
+	    long slice = LAZY_TREE_POLL_MILLISEC;
+
+	    if ( timeout_millisec > 0 )
+	    {
+		long remaining = timeout_millisec - std::chrono::duration_cast<std::chrono::milliseconds>
+		    ( std::chrono::steady_clock::now() - start ).count();
+
+		if ( remaining < slice )
+		    slice = remaining > 0 ? remaining : 1;
+	    }
+
+	    event = dialog->waitForEvent( slice );
+
+	    if ( event && event->eventType() != YEvent::TimeoutEvent )
+		return event;
+	}
+
+	if ( timeout_millisec > 0 )
+	{
+	    long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
+		( std::chrono::steady_clock::now() - start ).count();
+
+	    if ( elapsed >= timeout_millisec )
+		return dialog->waitForEvent( 1 );  // Let the UI create the timeout event
+	}
+    }
+
+    if ( timeout_millisec > 0 )
+    {
+	long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
+	    ( std::chrono::steady_clock::now() - start ).count();
+
+	timeout_millisec = elapsed < timeout_millisec ? timeout_millisec - elapsed : 1;
+    }
+
+    return dialog->waitForEvent( timeout_millisec );
+}
+
+
 /**
  * @builtin OpenDialog
  * @id OpenDialog_with_options
@@ -576,6 +670,13 @@ YCPBoolean YCP_UI::OpenDialog( const YCPTerm & opts, const YCPTerm & dialogTerm
 	YDialog * dialog = YUI::widgetFactory()->createDialog( dialogType, colorMode );
 	YUI_CHECK_NEW( dialog );
 
+	// Discard any stale ID index of a previous dialog at the same address
+	YCPWidgetIdIndex::removeDialog( dialog );
+	YCPItemIndex::removeDialog( dialog );
+	YCPItemsCache::removeDialog( dialog );
+	YCPLazyTableItems::removeDialog( dialog );
+	YCPLazyTreeItems::removeDialog( dialog );
+
 	YCPDialogParser::parseWidgetTreeTerm( dialog, dialogTerm );
 	dialog->open();
     }
@@ -585,6 +686,11 @@ YCPBoolean YCP_UI::OpenDialog( const YCPTerm & opts, const YCPTerm & dialogTerm
 
 	// Delete this half-created dialog:
 	// Some widgets are in a very undefined state (no children etc.)
+	YCPWidgetIdIndex::removeDialog( YDialog::topmostDialog( false ) );
+	YCPItemIndex::removeDialog( YDialog::topmostDialog( false ) );
+	YCPItemsCache::removeDialog( YDialog::topmostDialog( false ) );
+	YCPLazyTableItems::removeDialog( YDialog::topmostDialog( false ) );
+	YCPLazyTreeItems::removeDialog( YDialog::topmostDialog( false ) );
 	YDialog::deleteTopmostDialog();
 
 	ycperror( "UI::OpenDialog() failed" );
@@ -613,6 +719,11 @@ YCPBoolean YCP_UI::OpenDialog( const YCPTerm & opts, const YCPTerm & dialogTerm
 YCPValue YCP_UI::CloseDialog()
 {
     YUI::ui()->blockEvents();	// We don't want self-generated events from UI builtins.
+    YCPWidgetIdIndex::removeDialog( YDialog::topmostDialog( false ) );
+    YCPItemIndex::removeDialog( YDialog::topmostDialog( false ) );
+    YCPItemsCache::removeDialog( YDialog::topmostDialog( false ) );
+    YCPLazyTableItems::removeDialog( YDialog::topmostDialog( false ) );
+    YCPLazyTreeItems::removeDialog( YDialog::topmostDialog( false ) );
     YDialog::deleteTopmostDialog();
     YUI::ui()->unblockEvents();
 
@@ -660,6 +771,28 @@ void YCP_UI::CloseUI()
  *
  * For example in order to change the label of an InputField with id `name to
  * "anything", you write <tt>ChangeWidget( `id(`name), `Label, "anything" )</tt>.
+ *
+ * For widgets with items (Table, Tree, SelectionBox etc.), the
+ * <tt>`ItemsDiff</tt> property changes only some of the items instead of
+ * replacing all of them with <tt>`Items</tt>:
+ * <tt>ChangeWidget( `id(`table), `ItemsDiff, $[ "add": [ `item(...), ... ],
+ * "remove": [ itemId, ... ], "update": [ `item(...), ... ] ] )</tt>.
+ * Items to update are identified by their ID; for a Table, their cells are
+ * changed in place if possible. An item to add must not have the ID of an
+ * existing item (unless that one is removed by the same ItemsDiff) or of
+ * another item to add: Such an ItemsDiff is rejected without changing
+ * anything. Use <tt>"update"</tt> to change an existing item.
+ *
+ * The <tt>`Cells</tt> property of a Table changes many cells at once:
+ * <tt>ChangeWidget( `id(`table), `Cells, [ [ itemId, column, newValue ], ... ] )</tt>.
+ * <tt>newValue</tt> is the same as for <tt>`Cell( itemId, column )</tt>.
+ * Each changed cell is redrawn only once, no matter how often it appears in
+ * the list.
+ *
+ * The <tt>`Children( itemId )</tt> property of a Tree supplies the subitems
+ * of a <tt>`lazy</tt> item when the user opens it:
+ * <tt>ChangeWidget( `id(`tree), `Children( itemId ), [ `item(...), ... ] )</tt>.
+ *
  * @param symbol widgetId Can also be specified as `id( any widgetId )
  * @param symbol property
  * @param any newValue
@@ -675,68 +808,190 @@ YCPValue YCP_UI::ChangeWidget( const YCPValue & idValue, const YCPValue & proper
     {
 	YUI::ui()->blockEvents();	// We don't want self-generated events from UI::ChangeWidget().
 
-	if ( ! YCPDialogParser::isSymbolOrId( idValue ) )
-	{
-	    YUI_THROW( YUISyntaxErrorException( string( "Expected `id(...) or `symbol, not " ) +
-						idValue->toString().c_str() ) );
-	}
+	YWidget * widget	  = widgetForId( idValue );
+	bool	  shortcutChanged = false;
 
-	YCPValue   id	  = YCPDialogParser::parseIdTerm( idValue );
-	YWidget *  widget = YCPDialogParser::findWidgetWithId( id,
-                                                               true ); // throw if not found
+	ret = changeWidget( widget, property, newValue, shortcutChanged );
 
-	YPropertySet propSet = widget->propertySet();
+	if ( shortcutChanged )
+	    YDialog::currentDialog()->checkShortcuts();
+    }
+    catch( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+	ycperror( "UI::ChangeWidget failed: UI::ChangeWidget( %s, %s, %s )",
+		  idValue->toString().c_str(),
+		  property->toString().c_str(),
+		  newValue->toString().c_str() );
+	ret = YCPNull();
+    }
 
-	if ( property->isSymbol() )
-	{
-	    string oldShortcutString = widget->shortcutString();
-	    string propertyName	     = property->asSymbol()->symbol();
+    YUI::ui()->unblockEvents();
+
+    return ret;
+}
+
+
+YCPBoolean YCP_UI::changeWidget( YWidget *		widget,
+				 const YCPValue &	property,
+				 const YCPValue &	newValue,
+				 bool &			shortcutChanged )
+{
+    bool success = false;
+
+    // Make sure all items of a lazy table are there if the property needs them
+    YCPLazyTableItems::prepareProperty( widget, property, true );
+
+    if ( property->isSymbol() )
+    {
+	string oldShortcutString = widget->shortcutString();
+	string propertyName	 = property->asSymbol()->symbol();
 
+	if ( YCPPropertyHandler::propertyType( widget, propertyName ) == YOtherProperty ||
+	     YCPPropertyHandler::isBindingsProperty( propertyName ) )
+	{
+	    // Known to need special handling: Don't even try setProperty()
+	    success = YCPPropertyHandler::setComplexProperty( widget, propertyName, newValue );
+	}
+	else
+	{
 	    YPropertyValue val;
 
-	    if		( newValue->isString()  )	val = YPropertyValue( newValue->asString()->value()  );
-	    else if	( newValue->isInteger() )	val = YPropertyValue( newValue->asInteger()->value() );
-	    else if	( newValue->isBoolean() )	val = YPropertyValue( newValue->asBoolean()->value() );
+	    if	    ( newValue->isString()  )	val = YPropertyValue( newValue->asString()->value()  );
+	    else if ( newValue->isInteger() )	val = YPropertyValue( newValue->asInteger()->value() );
+	    else if ( newValue->isBoolean() )	val = YPropertyValue( newValue->asBoolean()->value() );
 	    else
 		val = YPropertyValue( false ); // Dummy value, will be rejected anyway
 
-	    bool success = widget->setProperty( propertyName, val );
+	    success = widget->setProperty( propertyName, val );
 
 	    if ( ! success )
 	    {
 		// Try again with the known special cases
 		success = YCPPropertyHandler::setComplexProperty( widget, propertyName, newValue );
 	    }
+	}
 
-	    ret = YCPBoolean( success );
+	if ( oldShortcutString != widget->shortcutString() )
+	    shortcutChanged = true;
+    }
+    else if ( property->isTerm() )
+    {
+	success = YCPPropertyHandler::setComplexProperty( widget, property->asTerm(), newValue );
+    }
+    else
+    {
+	YUI_THROW( YUISyntaxErrorException( string( "Bad UI::ChangeWidget args: " )
+					    + property->toString() ) );
+    }
 
-	    if ( oldShortcutString != widget->shortcutString() )
-		YDialog::currentDialog()->checkShortcuts();
-	}
-	else if ( property->isTerm() )
-	{
-	    bool success = YCPPropertyHandler::setComplexProperty( widget, property->asTerm(), newValue );
-	    ret	 = YCPBoolean( success );
-	}
-	else
+    return YCPBoolean( success );
+}
+
+
+YWidget * YCP_UI::widgetForId( const YCPValue & idValue )
+{
+    if ( ! YCPDialogParser::isSymbolOrId( idValue ) )
+    {
+	YUI_THROW( YUISyntaxErrorException( string( "Expected `id(...) or `symbol, not " ) +
+					    idValue->toString().c_str() ) );
+    }
+
+    YCPValue id = YCPDialogParser::parseIdTerm( idValue );
+
+    return YCPDialogParser::findWidgetWithId( id,
+					      true ); // throw if not found
+}
+
+
+
+/**
+ * @builtin ChangeWidgets
+ * @short Changes several widgets at once
+ * @description
+ * Changes any number of widget properties of the topmost dialog with one
+ * call. Each entry of <tt>changes</tt> is a list <tt>[ widgetId, property,
+ * newValue ]</tt> just like the arguments of <tt>ChangeWidget</tt>.
+ *
+ * This is equivalent to calling <tt>ChangeWidget</tt> for each entry, but
+ * the screen is updated only once at the end, and the keyboard shortcuts
+ * are checked only once. Use this for dialogs that update many widgets at
+ * once, e.g. progress screens.
+ *
+ * An entry that fails does not prevent the other entries from being
+ * applied.
+ *
+ * @param list changes list of [ widgetId, property, newValue ] lists
+ *
+ * @return list<boolean> Success of each entry (in the same order)
+ *
+ * @example ChangeWidgets1.rb
+ */
+
+YCPList YCP_UI::ChangeWidgets( const YCPList & changes )
+{
+    YCPList results;
+    YDialog * dialog = YDialog::currentDialog( false );
+
+    if ( ! dialog )
+    {
+	ycperror( "UI::ChangeWidgets(): No dialog" );
+
+	for ( int i=0; i < changes->size(); i++ )
+	    results->add( YCPBoolean( false ) );
+
+	return results;
+    }
+
+    YUI::ui()->blockEvents();	// We don't want self-generated events from UI::ChangeWidgets().
+
+    bool shortcutChanged = false;
+
+    {
+	YWidget::OptimizeChanges below( *dialog ); // delay screen updates until this block is left
+
+	for ( int i=0; i < changes->size(); i++ )
 	{
-	    YUI_THROW( YUISyntaxErrorException( string( "Bad UI::ChangeWidget args: " )
-						+ property->toString() ) );
+	    YCPValue change  = changes->value( i );
+	    bool     success = false;
+
+	    try
+	    {
+		if ( ! change->isList() || change->asList()->size() != 3 )
+		{
+		    YUI_THROW( YUISyntaxErrorException( string( "Expected [ widgetId, property, newValue ], not " ) +
+							change->toString() ) );
+		}
+
+		YCPList	  args	 = change->asList();
+		YWidget * widget = widgetForId( args->value(0) );
+
+		success = changeWidget( widget, args->value(1), args->value(2), shortcutChanged )->value();
+	    }
+	    catch( YUIException & exception )
+	    {
+		YUI_CAUGHT( exception );
+		ycperror( "UI::ChangeWidgets failed for entry #%d: %s",
+			  i, change->toString().c_str() );
+	    }
+
+	    results->add( YCPBoolean( success ) );
 	}
     }
+
+    try
+    {
+	if ( shortcutChanged )
+	    dialog->checkShortcuts();
+    }
     catch( YUIException & exception )
     {
 	YUI_CAUGHT( exception );
-	ycperror( "UI::ChangeWidget failed: UI::ChangeWidget( %s, %s, %s )",
-		  idValue->toString().c_str(),
-		  property->toString().c_str(),
-		  newValue->toString().c_str() );
-	ret = YCPNull();
     }
 
     YUI::ui()->unblockEvents();
 
-    return ret;
+    return results;
 }
 
 
@@ -752,6 +1007,12 @@ YCPValue YCP_UI::ChangeWidget( const YCPValue & idValue, const YCPValue & proper
  * <tt>QueryWidget( `id( `table ), `Item( 17 ) )</tt> for a table where you query a
  * certain item.
  *
+ * For a Table, <tt>QueryWidget( `id( `table ), `Items( `columns, [ 0, 2 ] ) )</tt>
+ * returns the items with only the cells of the specified columns. For any
+ * widget with items, <tt>`ItemIds</tt> returns just the IDs of all items
+ * (including nested items, in the same order as <tt>`Items</tt>). Both are
+ * much cheaper than querying all of <tt>`Items</tt>.
+ *
  * @param  symbol widgetId Can also be specified as `id( any id )
  * @param symbol|term property
  * @return any
@@ -763,55 +1024,126 @@ YCPValue YCP_UI::QueryWidget( const YCPValue & idValue, const YCPValue & propert
 
     try
     {
-	if ( ! YCPDialogParser::isSymbolOrId( idValue ) )
+	YWidget * widget = widgetForId( idValue );
+	ret = queryWidget( widget, property );
+    }
+    catch( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+	ycperror( "UI::QueryWidget failed: UI::QueryWidget( %s, %s )",
+		  idValue->toString().c_str(),
+		  property->toString().c_str() );
+	ret = YCPNull();
+    }
+
+    return ret;
+}
+
+
+YCPValue YCP_UI::queryWidget( YWidget * widget, const YCPValue & property )
+{
+    // Make sure all items of a lazy table are there if the property needs them
+    YCPLazyTableItems::prepareProperty( widget, property, false );
+
+    if ( property->isSymbol() )		// The normal case: UI::QueryWidget(`myWidget, `SomeProperty)
+    {
+	string propertyName = property->asSymbol()->symbol();
+
+	if ( YCPPropertyHandler::propertyType( widget, propertyName ) == YOtherProperty ||
+	     YCPPropertyHandler::isBindingsProperty( propertyName ) )
 	{
-	    YUI_THROW( YUISyntaxErrorException( string( "Expected `id(...) or `symbol, not " ) +
-						idValue->toString().c_str() ) );
+	    // Known to need special handling: Don't even try getProperty()
+	    return YCPPropertyHandler::getComplexProperty( widget, propertyName );
 	}
 
-	YCPValue id = YCPDialogParser::parseIdTerm( idValue );
-	YWidget *widget = YCPDialogParser::findWidgetWithId( id,
-							     true ); // throw if not found
-
-	YPropertySet propSet = widget->propertySet();
+	YPropertyValue val  = widget->getProperty( propertyName );
 
-	if ( property->isSymbol() )		// The normal case: UI::QueryWidget(`myWidget, `SomeProperty)
+	switch ( val.type() )
 	{
-	    string propertyName = property->asSymbol()->symbol();
-	    YPropertyValue val  = widget->getProperty( propertyName );
+	    case YStringProperty:	return YCPString ( val.stringVal()  );
+	    case YBoolProperty:		return YCPBoolean( val.boolVal()    );
+	    case YIntegerProperty:	return YCPInteger( val.integerVal() );
+	    case YOtherProperty:	return YCPPropertyHandler::getComplexProperty( widget, propertyName );
+
+	    default:
+		ycperror( "Unknown result for setProperty( %s )", propertyName.c_str() );
+		return YCPVoid();
+	}
+    }
+    else if ( property->isTerm() )	// Very rare: UI::QueryWidget(`myTable, `Item("abc", 3) )
+    {
+	return YCPPropertyHandler::getComplexProperty( widget, property->asTerm() );
+    }
+    else
+    {
+	YUI_THROW( YUISyntaxErrorException( string( "Bad UI::QueryWidget args: " )
+					    + property->toString() ) );
+    }
+
+    return YCPVoid();
+}
+
+
+
+/**
+ * @builtin QueryWidgets
+ * @short Queries several widget properties at once
+ * @description
+ * Queries any number of widget properties of the topmost dialog with one
+ * call. Each entry of <tt>queries</tt> is a list <tt>[ widgetId, property
+ * ]</tt> just like the arguments of <tt>QueryWidget</tt>.
+ *
+ * This is equivalent to calling <tt>QueryWidget</tt> for each entry, but
+ * much cheaper for many queries, e.g. when saving the state of a complete
+ * dialog.
+ *
+ * The result is a map with the <tt>[ widgetId, property ]</tt> entries as
+ * keys and the property values as values. The value of an entry that
+ * failed (e.g. no widget with that ID) is nil.
+ *
+ * @param list queries list of [ widgetId, property ] lists
+ *
+ * @return map<list,any>
+ *
+ * @example QueryWidgets1.rb
+ */
+
+YCPMap YCP_UI::QueryWidgets( const YCPList & queries )
+{
+    YCPMap results;
 
-	    switch ( val.type() )
+    for ( int i=0; i < queries->size(); i++ )
+    {
+	YCPValue query = queries->value( i );
+	YCPValue val   = YCPVoid();
+
+	try
+	{
+	    if ( ! query->isList() || query->asList()->size() != 2 )
 	    {
-		case YStringProperty:	return YCPString ( val.stringVal()  );
-		case YBoolProperty:	return YCPBoolean( val.boolVal()    );
-		case YIntegerProperty:	return YCPInteger( val.integerVal() );
-		case YOtherProperty:	return YCPPropertyHandler::getComplexProperty( widget, propertyName );
-
-		default:
-		    ycperror( "Unknown result for setProperty( %s )", propertyName.c_str() );
-		    return YCPVoid();
+		YUI_THROW( YUISyntaxErrorException( string( "Expected [ widgetId, property ], not " ) +
+						    query->toString() ) );
 	    }
+
+	    YCPList   args   = query->asList();
+	    YWidget * widget = widgetForId( args->value(0) );
+
+	    val = queryWidget( widget, args->value(1) );
+
+	    if ( val.isNull() )
+		val = YCPVoid();
 	}
-	else if ( property->isTerm() )	// Very rare: UI::QueryWidget(`myTable, `Item("abc", 3) )
-	{
-	    return YCPPropertyHandler::getComplexProperty( widget, property->asTerm() );
-	}
-	else
+	catch( YUIException & exception )
 	{
-	    YUI_THROW( YUISyntaxErrorException( string( "Bad UI::QueryWidget args: " )
-						+ property->toString() ) );
+	    YUI_CAUGHT( exception );
+	    ycperror( "UI::QueryWidgets failed for entry #%d: %s",
+		      i, query->toString().c_str() );
 	}
-    }
-    catch( YUIException & exception )
-    {
-	YUI_CAUGHT( exception );
-	ycperror( "UI::QueryWidget failed: UI::QueryWidget( %s, %s )",
-		  idValue->toString().c_str(),
-		  property->toString().c_str() );
-	ret = YCPNull();
+
+	results->add( query, val );
     }
 
-    return ret;
+    return results;
 }
 
 
@@ -858,6 +1190,11 @@ YCPBoolean YCP_UI::ReplaceWidget( const YCPValue & idValue, const YCPTerm & newC
 	YDialog * dialog = YDialog::currentDialog();
 
 	YWidget::OptimizeChanges below( *dialog ); // delay screen updates until this block is left
+	YCPWidgetIdIndex::removeChildren( dialog, replacePoint );
+	YCPItemIndex::removeChildren( replacePoint );
+	YCPItemsCache::removeChildren( replacePoint );
+	YCPLazyTableItems::removeChildren( replacePoint );
+	YCPLazyTreeItems::removeChildren( replacePoint );
 	replacePoint->deleteChildren();
 
 	YCPDialogParser::parseWidgetTreeTerm( replacePoint, newContentTerm );
@@ -1727,4 +2064,127 @@ YCPValue YCP_UI::SetApplicationTitle( const YCPString & title )
     return YCPVoid();
 }
 
+
+/**
+ * @builtin SetAsyncMode
+ * @short Queue UI calls whose result is not needed
+ * @description
+ * In async mode, calls of <tt>ChangeWidget</tt>, <tt>WizardCommand</tt>,
+ * <tt>BusyCursor</tt>, <tt>NormalCursor</tt> and <tt>Beep</tt> are not
+ * executed right away, but queued; they return immediately (ChangeWidget
+ * and WizardCommand return true). The queued calls are executed in the
+ * order they were made before any other UI call (like <tt>UserInput</tt>
+ * or <tt>QueryWidget</tt>), when there are many of them, or when another
+ * call is queued and the first of them has been waiting for 100
+ * milliseconds. There is no timer: Queued calls are not executed while the
+ * application does anything else than UI calls, so call
+ * <tt>FlushAsyncCalls</tt> before any long operation that doesn't update
+ * the screen, or the screen shows outdated information until then.
+ *
+ * Use this for loops that update the screen very often, like progress
+ * updates during a long operation. Errors of queued calls are only logged.
+ *
+ * A queued ChangeWidget call for the <tt>`Value</tt>, <tt>`Label</tt> or
+ * <tt>`Values</tt> property is dropped when a later call changes the same
+ * property of the same widget: Only the latest value would be visible
+ * anyway. See also <tt>AsyncCallStats</tt>.
+ *
+ * Disabling async mode executes all queued calls.
+ *
+ * @param boolean async true to enable async mode, false to disable it
+ */
+void YCP_UI::SetAsyncMode( const YCPBoolean & async )
+{
+    // All queued calls were already executed before this call
+    // (see YUIFunction::evaluateCall())
+
+    YCPAsyncCalls::setEnabled( async->value() );
+}
+
+
+/**
+ * @builtin FlushAsyncCalls
+ * @short Execute all queued UI calls now
+ * @description
+ * Execute all calls that were queued in async mode (see
+ * <tt>SetAsyncMode</tt>) now. Any UI call whose result is needed does this
+ * anyway, but call this before a long operation without any UI calls so
+ * the screen shows the latest state during that operation.
+ */
+void YCP_UI::FlushAsyncCalls()
+{
+    // Nothing left to do: All queued calls were executed before this call
+    // (see YUIFunction::evaluateCall())
+}
+
+
+/**
+ * @builtin AsyncCallStats
+ * @short Statistics about UI calls queued in async mode
+ * @description
+ * Return how many calls were queued in async mode (see
+ * <tt>SetAsyncMode</tt>), how many of them were executed and how many were
+ * dropped because a later ChangeWidget call changed the same
+ * <tt>`Value</tt>, <tt>`Label</tt> or <tt>`Values</tt> property of the same
+ * widget. The dropped calls are also counted for each property:
+ *
+ * <tt>$[ "queued": 2000, "executed": 200, "coalesced": 1800,
+ * "coalesced_by_property": $[ "Value": 1000, "Label": 800 ] ]</tt>
+ *
+ * @return map statistics
+ */
+YCPMap YCP_UI::AsyncCallStats()
+{
+    return YCPAsyncCalls::stats();
+}
+
+
+/**
+ * @builtin BeginBatch
+ * @short Start recording a batch of UI calls
+ * @description
+ * All UI calls after this (except those that wait for user input like
+ * <tt>UserInput</tt> or <tt>WaitForEvent</tt>) are only recorded, not
+ * executed: They return nil. <tt>EndBatch</tt> executes all of them in the
+ * order they were made and returns their results.
+ *
+ * The screen is updated only once for the whole batch (for each dialog
+ * opened or closed in the batch, if any), and no events are generated by the
+ * changes in the batch. Use this to update many widgets of a dialog at
+ * once.
+ *
+ * Don't use the results of the calls in the batch (they are all nil) before
+ * <tt>EndBatch</tt>.
+ *
+ * A batch must always be ended with <tt>EndBatch</tt>. If it isn't (e.g.
+ * because of an exception), the next call that waits for user input, the
+ * next <tt>CloseUI</tt> or the next <tt>BeginBatch</tt> logs an error and
+ * executes the pending batch first; its results are lost.
+ */
+void YCP_UI::BeginBatch()
+{
+    YCPBatchCalls::begin();
+}
+
+
+/**
+ * @builtin EndBatch
+ * @short Execute a batch of UI calls
+ * @description
+ * Execute all UI calls recorded since <tt>BeginBatch</tt> and return the list
+ * of their results in the same order. If one of the calls fails with an
+ * internal error, it and the remaining calls are not executed, and their
+ * results are nil: The list always has one entry for each recorded call.
+ *
+ * @return list results of the calls
+ * @usage UI::BeginBatch();
+ * UI::ChangeWidget( `id(`name), `Value, name );
+ * UI::ChangeWidget( `id(`ok), `Enabled, name != "" );
+ * list results = UI::EndBatch();
+ */
+YCPList YCP_UI::EndBatch()
+{
+    return YCPBatchCalls::execute();
+}
+
 // EOF
@@ -38,8 +38,13 @@ you may find current contact information at www.novell.com
 #include <ycp/YCPTerm.h>
 #include <ycp/YCPInteger.h>
 #include <ycp/YCPMap.h>
+#include <ycp/YCPList.h>
 #include <ycp/YCPBoolean.h>
 
+class YWidget;
+class YDialog;
+class YEvent;
+
 
 class YCP_UI
 {
@@ -56,6 +61,7 @@ public:
     static void 	BusyCursor			();
     static void 	Beep     			();
     static YCPValue 	ChangeWidget			( const YCPValue & widgetId, const YCPValue & property, const YCPValue & new_value );
+    static YCPList 	ChangeWidgets			( const YCPList & changes );
     static void 	CheckShortcuts			();
     static YCPValue 	CloseDialog			();
     static void 	CloseUI				();
@@ -74,6 +80,7 @@ public:
     static void 	PlayMacro			( const YCPString & filename );
     static void 	PostponeShortcutCheck		();
     static YCPValue 	QueryWidget			( const YCPValue & widgetId, const YCPValue& property );
+    static YCPMap 	QueryWidgets			( const YCPList & queries );
     static void 	RecalcLayout			();
     static YCPValue 	Recode				( const YCPString & fromEncoding, const YCPString & toEncoding, const YCPString & text );
     static void 	RecordMacro			( const YCPString & fileName );
@@ -103,6 +110,11 @@ public:
     static YCPValue	SetProductLogo			( const YCPBoolean & show_logo);
     static YCPValue	SetApplicationIcon      	( const YCPString & icon);
     static YCPValue	SetApplicationTitle      	( const YCPString & text);
+    static void		SetAsyncMode			( const YCPBoolean & async );
+    static void		FlushAsyncCalls			();
+    static YCPMap	AsyncCallStats			();
+    static void		BeginBatch			();
+    static YCPList	EndBatch			();
 
 
 
@@ -111,6 +123,15 @@ public:
      **/
     static YCPValue	evaluateCallback		( const YCPTerm & term, bool to_wfm );
 
+    /**
+     * Not really a UI built-in: Common part of QueryWidget() and
+     * QueryWidgets(). Return the value of property 'property' of 'widget'.
+     * This is also used by the macro recorder which already has the widget.
+     *
+     * Throws exceptions upon syntax errors.
+     **/
+    static YCPValue	queryWidget			( YWidget * widget, const YCPValue & property );
+
 protected:
 
     /**
@@ -137,6 +158,38 @@ protected:
 				 bool 		wait,
 				 bool 		detailed );
 
+    /**
+     * Wait for an event in 'dialog' like YDialog::waitForEvent(), but add
+     * the remaining items of any lazy tables (see YCPLazyTableItems) chunk
+     * by chunk while there is no event yet. If 'lazyTreeEvents' is true,
+     * also return an event when the user opens a lazy tree item (see
+     * YCPLazyTreeItems).
+     **/
+    static YEvent * waitForEvent( YDialog *	dialog,
+				  long		timeout_millisec,
+				  bool		lazyTreeEvents );
+
+    /**
+     * Common part of ChangeWidget() and ChangeWidgets():
+     * Change property 'property' of 'widget' to 'newValue'.
+     *
+     * This does not check the keyboard shortcuts; it only sets
+     * 'shortcutChanged' if the widget's shortcut changed, so the caller can
+     * check them once for any number of changes.
+     *
+     * Throws exceptions upon syntax errors.
+     **/
+    static YCPBoolean changeWidget( YWidget *		widget,
+				    const YCPValue &	property,
+				    const YCPValue &	newValue,
+				    bool &		shortcutChanged );
+
+    /**
+     * Return the widget of the current dialog with ID 'idValue'
+     * (`id(...) or `symbol). Throws exceptions if there is no such widget.
+     **/
+    static YWidget * widgetForId( const YCPValue & idValue );
+
     //
     // Data members
     //
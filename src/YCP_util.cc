@@ -77,6 +77,20 @@ float toFloat( const YCPValue & val )
 }
 
 
+YCPString cachedYCPString( YCPString & cached, const string & str )
+{
+    if ( ! cached.isNull() )
+    {
+	if ( str == cached->value_cstr() )
+	    return cached;
+
+	cached = YCPNull();	// Outdated: Don't keep a second copy of the label
+    }
+
+    return YCPString( str );
+}
+
+
 // FIXME: The following code is ugly
 // FIXME: The following code is ugly
 // FIXME: The following code is ugly
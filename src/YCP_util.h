@@ -32,6 +32,7 @@ you may find current contact information at www.novell.com
 #include <iostream>
 
 #include <ycp/YCPValue.h>
+#include <ycp/YCPString.h>
 
 
 /**
@@ -50,6 +51,21 @@ bool isNum( const YCPValue & val );
 float toFloat( const YCPValue & val );
 
 
+/**
+ * Return 'cached' if it is non-null and has the value 'str'. Otherwise,
+ * return a new YCPString with that value and drop 'cached' for good.
+ *
+ * This is for item classes that keep the YCPStrings they were created with,
+ * so they can return them without creating a copy. Such a string is shared
+ * with the YCP list the item was parsed from, but once that list is gone,
+ * it is a second copy of the label next to the std::string in libyui. So
+ * it is never replaced: If the label was changed behind the item's back
+ * (the libyui setters are not virtual), it is dropped, and each query
+ * creates a temporary YCPString like it did before.
+ **/
+YCPString cachedYCPString( YCPString & cached, const string & str );
+
+
 /**
  * Recode a string from or to UTF-8.
  **/
@@ -46,6 +46,8 @@ you may find current contact information at www.novell.com
 #include "YUIComponent.h"
 #include "YUINamespace.h"
 #include "YCPBuiltinCaller.h"
+#include "YCPAsyncCalls.h"
+#include "YCPBatchCalls.h"
 #include <yui/YMacro.h>
 
 #define VERBOSE_UI_CALLS	0
@@ -294,6 +296,56 @@ YUINamespace::SetApplicationTitle( const YCPString & text)
 }
 
 
+YCPValue
+YUINamespace::SetAsyncMode( const YCPBoolean & async )
+{
+    if ( YUIComponent::ui() )
+	YCP_UI::SetAsyncMode( async );
+
+    return YCPVoid();
+}
+
+
+YCPValue
+YUINamespace::FlushAsyncCalls()
+{
+    if ( YUIComponent::ui() )
+	YCP_UI::FlushAsyncCalls();
+
+    return YCPVoid();
+}
+
+
+YCPValue
+YUINamespace::AsyncCallStats()
+{
+    if ( YUIComponent::ui() )
+	return YCP_UI::AsyncCallStats();
+    else
+	return YCPVoid();
+}
+
+
+YCPValue
+YUINamespace::BeginBatch()
+{
+    if ( YUIComponent::ui() )
+	YCP_UI::BeginBatch();
+
+    return YCPVoid();
+}
+
+
+YCPValue
+YUINamespace::EndBatch()
+{
+    if ( YUIComponent::ui() )
+	return YCP_UI::EndBatch();
+    else
+	return YCPList();
+}
+
+
 YCPValue
 YUINamespace::ChangeWidget( const YCPTerm & widget_id, const YCPSymbol & property, const YCPValue & new_value )
 {
@@ -314,6 +366,16 @@ YUINamespace::ChangeWidget( const YCPTerm & widget_id, const YCPTerm & property,
 }
 
 
+YCPValue
+YUINamespace::ChangeWidgets( const YCPList & changes )
+{
+    if ( YUIComponent::ui() )
+	return YCP_UI::ChangeWidgets( changes );
+    else
+	return YCPVoid();
+}
+
+
 YCPValue
 YUINamespace::QueryWidget( const YCPSymbol & widget_id, const YCPSymbol & property )
 {
@@ -354,6 +416,16 @@ YUINamespace::QueryWidget( const YCPTerm & widget_id, const YCPTerm & property )
 }
 
 
+YCPValue
+YUINamespace::QueryWidgets( const YCPList & queries )
+{
+    if ( YUIComponent::ui() )
+	return YCP_UI::QueryWidgets( queries );
+    else
+	return YCPVoid();
+}
+
+
 YCPValue
 YUINamespace::ReplaceWidget( const YCPSymbol & widget_id, const YCPTerm & new_widget )
 {
@@ -705,11 +777,30 @@ m_position (pos)
 , m_param3 ( YCPNull() )
 , m_param4 ( YCPNull() )
 , m_param5 ( YCPNull() )
+, m_async_result ( YCPNull() )
+, m_async_coalesce ( false )
+, m_batch_record ( false )
+, m_batch_barrier ( false )
+, m_batch_end ( false )
 {
 
 };
 
 
+YUIFunction * YUIFunction::clone() const
+{
+    YUIFunction * function = new YUIFunction( m_instance, m_comp, m_position, m_play_macro_blocks );
+
+    function->m_param1 = m_param1;
+    function->m_param2 = m_param2;
+    function->m_param3 = m_param3;
+    function->m_param4 = m_param4;
+    function->m_param5 = m_param5;
+
+    return function;
+}
+
+
 bool YUIFunction::attachParameter (const YCPValue& arg, const int position)
 {
     switch (position)
@@ -726,6 +817,20 @@ bool YUIFunction::attachParameter (const YCPValue& arg, const int position)
 }
 
 
+YCPValue YUIFunction::parameter( int position ) const
+{
+    switch (position)
+    {
+	case 0: return m_param1;
+	case 1: return m_param2;
+	case 2: return m_param3;
+	case 3: return m_param4;
+	case 4: return m_param5;
+	default: return YCPNull();
+    }
+}
+
+
 constTypePtr YUIFunction::wantedParameterType() const
 {
     // we do not help them with type conversion
@@ -788,37 +893,36 @@ YCPValue YUIFunction::evaluateCall()
     if ( ! m_comp->ui() )
 	return YCPVoid();	// dummy UI component
 
-    if ( m_play_macro_blocks && YMacro::playing() )
+    if ( m_batch_record && YCPBatchCalls::recording() )
     {
-	YMacro::playNextBlock();
-    }
+	// Executed by UI::EndBatch(); the result is returned there
+	YCPBatchCalls::add( clone(), m_batch_barrier );
 
-    YCPValue ret = YCPVoid();
+	return YCPVoid();
+    }
 
-    if ( m_comp->ui()->runningWithThreads() )
+    if ( ! m_async_result.isNull() && YCPAsyncCalls::enabled() )
     {
-	YCPBuiltinCaller * builtinCaller =
-	    dynamic_cast<YCPBuiltinCaller *> (m_comp->ui()->builtinCaller() );
+	// The interpreter may reuse this object with other parameters
+	YCPAsyncCalls::add( m_comp->ui(), clone(), m_async_coalesce );
 
-	if ( ! builtinCaller )
-	{
-	    builtinCaller = new YCPBuiltinCaller();
-	    m_comp->ui()->setBuiltinCaller( builtinCaller );
-	}
+	return m_async_result;
+    }
 
-	if ( builtinCaller )
-	{
-	    builtinCaller->setFunction( this );
+    // Keep the order: Execute all queued calls before this one
+    YCPAsyncCalls::flush( m_comp->ui() );
 
-	    m_comp->ui()->signalUIThread();
+    if ( m_play_macro_blocks && YMacro::playing() )
+    {
+	YMacro::playNextBlock();
+    }
 
-	    while ( ! m_comp->ui()->waitForUIThread() )
-	    {
-		// NOP
-	    }
+    YCPValue ret = YCPVoid();
 
-	    ret = builtinCaller->result();
-	}
+    if ( m_comp->ui()->runningWithThreads() )
+    {
+	YCPBuiltinCaller * builtinCaller = YCPBuiltinCaller::builtinCaller( m_comp->ui() );
+	ret = builtinCaller->callInUIThread( m_comp->ui(), this );
     }
     else
     {
@@ -831,6 +935,13 @@ YCPValue YUIFunction::evaluateCall()
 
 YCPValue YUIFunction::evaluateCall_int()
 {
+    // Don't let a batch that was never ended swallow all further UI calls
+    // or fall behind a call that waits for user input. This runs in the UI
+    // thread, just like UI::EndBatch().
+
+    if ( m_batch_end )
+	YCPBatchCalls::executePending();
+
     switch (m_position)
     {
 #include "UIBuiltinCalls.h"
@@ -949,6 +1060,7 @@ YUIOverloadedFunction::finishParameters()
 
 
 YUINamespace::YUINamespace (YUIComponent* comp)
+    : _indexedSymbols( 0 )
 {
     m_comp = comp;
     registerFunctions();
@@ -961,6 +1073,13 @@ YUINamespace::~YUINamespace()
 }
 
 
+void YUINamespace::setCallFlags( YUIFunction * function, const SymbolRange * range )
+{
+    function->setAsyncResult( range->asyncResult, range->asyncCoalesce );
+    function->setBatchFlags( range->batchRecord, range->batchBarrier, range->batchEnd );
+}
+
+
 Y2Function* YUINamespace::createFunctionCall( const string name, constFunctionTypePtr type )
 {
 #if VERBOSE_UI_CALLS
@@ -968,64 +1087,51 @@ Y2Function* YUINamespace::createFunctionCall( const string name, constFunctionTy
     y2debug ("whose type is %s", type? type->toString().c_str() : "unknown");
 #endif
 
-    // overloading: functions with same name must be adjacent in m_symbols
-
-    symbols_t::iterator
-	b = m_symbols.begin(),
-	e  = m_symbols.end(),
-	it = b;
-    SymbolEntryPtr p;
-
     //
-    // 1: Find start of range of overloaded functions
+    // 1: Look up the range of overloaded functions in the index
     //
 
-    for ( ; it != e; it++ )
-    {
-	p = (*it);
-	if ( p->name() == name )
-	    break;
-    }
+    const SymbolRange * range = findSymbols( name );
 
-    if ( it == e )
+    if ( ! range )
     {
         y2error ("No such function %s", name.c_str());
         return NULL;
     }
 
-    bool play_macro_blocks =
-	( name == YUIBuiltin_UserInput        ||
-	  name == YUIBuiltin_TimeoutUserInput ||
-	  name == YUIBuiltin_WaitForEvent       );
+    symbols_t::iterator
+	b  = m_symbols.begin(),
+	rb = b + range->begin,
+	re = b + range->end,
+	it;
+    // [rb, re) have matching name
 
-    symbols_t::iterator rb = it;
-    // 2: find end of range of overloaded functions or the exact match
+    //
+    // 2: Find the exact match
+    //
+    // There are only very few overloads of any builtin, so this is cheaper
+    // than hashing the type.
 
-    for ( ; it != e; it++ )
+    if ( type )
     {
-	p = (*it);
-	if ( p->name() != name )
-	    break;
-
-	// type comparison, ugh, use match
-
-	if ( type && p->type() == type )
+	for ( it = rb; it != re; it++ )
 	{
-	    // found exact match
-	    // BTW, p->position() may change as we go, don't get confused.
-	    // What matters is our own counting.
+	    // type comparison, ugh, use match
+
+	    if ( (*it)->type() == type )
+	    {
+		// found exact match
+		// BTW, p->position() may change as we go, don't get confused.
+		// What matters is our own counting.
 #if VERBOSE_UI_CALLS
-	    y2debug ("Found symbol '%s' @%d", p->toString().c_str(), p->position());
+		y2debug ("Found symbol '%s' @%d", (*it)->toString().c_str(), (*it)->position());
 #endif
-	    return new YUIFunction (this, m_comp, it - b, play_macro_blocks);
+		YUIFunction * function = new YUIFunction (this, m_comp, it - b, range->playMacroBlocks);
+		setCallFlags( function, range );
+		return function;
+	    }
 	}
-    }
 
-    symbols_t::iterator re = it;
-    // [rb, re) have matching name
-
-    if ( type )
-    {
 	// we have exhausted the candidates without finding a match
 	y2error ("Incompatible yast2-core?");
 	no_match (name.c_str(), type, rb, re);
@@ -1033,12 +1139,77 @@ Y2Function* YUINamespace::createFunctionCall( const string name, constFunctionTy
     }
 
     y2debug ("overloaded %s, %td@%td", name.c_str(), re - rb, rb - b);
-    return new YUIOverloadedFunction (this, m_comp, rb - b, rb, re, play_macro_blocks);
+    YUIFunction * function = new YUIOverloadedFunction (this, m_comp, rb - b, rb, re, range->playMacroBlocks);
+    setCallFlags( function, range );
+    return function;
+}
+
+
+const YUINamespace::SymbolRange *
+YUINamespace::findSymbols( const string & name )
+{
+    if ( _indexedSymbols != m_symbols.size() )
+	buildSymbolIndex();
+
+    std::unordered_map<string, SymbolRange>::const_iterator it = _symbolIndex.find( name );
+
+    return it == _symbolIndex.end() ? 0 : &( it->second );
+}
+
+
+void YUINamespace::buildSymbolIndex()
+{
+    // overloading: functions with same name must be adjacent in m_symbols
+
+    _symbolIndex.clear();
+    SymbolRange * range = 0;
+
+    for ( size_t i = 0; i < m_symbols.size(); i++ )
+    {
+	const string & name = m_symbols[i]->name();
+
+	if ( range && m_symbols[ range->begin ]->name() == name )
+	{
+	    range->end = i + 1;
+	    continue;
+	}
+
+	if ( _symbolIndex.find( name ) != _symbolIndex.end() )
+	{
+	    // Not adjacent to its other overloads: Like the old linear
+	    // search, only use the first range with that name.
+
+	    range = 0;
+	    continue;
+	}
+
+	range = &( _symbolIndex[ name ] );
+	range->begin = i;
+	range->end   = i + 1;
+
+	range->playMacroBlocks =
+	    ( name == YUIBuiltin_UserInput        ||
+	      name == YUIBuiltin_TimeoutUserInput ||
+	      name == YUIBuiltin_WaitForEvent       );
+
+	range->asyncResult   = YCPAsyncCalls::queuedResult( name );
+	range->asyncCoalesce = YCPAsyncCalls::mayCoalesce( name );
+	range->batchRecord   = YCPBatchCalls::mayRecord( name );
+	range->batchBarrier  = YCPBatchCalls::isBarrier( name );
+	range->batchEnd      = YCPBatchCalls::endsBatch( name );
+    }
+
+    _indexedSymbols = m_symbols.size();
+
+    y2debug ("Indexed %zu UI builtins in %zu symbols",
+	     _symbolIndex.size(), _indexedSymbols);
 }
 
 
 void YUINamespace::registerFunctions()
 {
 #include "UIBuiltinTable.h"
+
+    buildSymbolIndex();
 }
 
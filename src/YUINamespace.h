@@ -30,12 +30,15 @@ you may find current contact information at www.novell.com
 /-*/
 
 
+#include <unordered_map>
+
 #include <y2/Y2Namespace.h>
 #include <y2/Y2Function.h>
 #include <ycp/YCPBoolean.h>
 #include <ycp/YCPInteger.h>
 #include <ycp/YCPVoid.h>
 #include <ycp/YCPString.h>
+#include <ycp/YCPList.h>
 #include <ycp/YCPCode.h>
 #include <ycp/StaticDeclaration.h>
 
@@ -60,6 +63,11 @@ protected:
     YCPValue m_param3;
     YCPValue m_param4;
     YCPValue m_param5;
+    YCPValue m_async_result;
+    bool m_async_coalesce;
+    bool m_batch_record;
+    bool m_batch_barrier;
+    bool m_batch_end;
 public:
 
     YUIFunction (YUINamespace* instance, YUIComponent* comp, unsigned int pos, bool play_macro_blocks);
@@ -72,6 +80,32 @@ public:
     YCPValue evaluateCall_int();
     bool reset();
     string name () const;
+
+    /**
+     * Allow this call to be queued in async mode (see YCPAsyncCalls):
+     * It then returns 'result' right away. If 'coalesce' is true, a queued
+     * call may be replaced by a later one that changes the same thing.
+     **/
+    void setAsyncResult( const YCPValue & result, bool coalesce )
+	{ m_async_result = result; m_async_coalesce = coalesce; }
+
+    /**
+     * Allow this call to be recorded in a batch (see YCPBatchCalls).
+     * 'barrier' means this call creates or deletes dialogs, 'end' means a
+     * batch that is still being recorded must be executed before this call.
+     **/
+    void setBatchFlags( bool record, bool barrier, bool end )
+	{ m_batch_record = record; m_batch_barrier = barrier; m_batch_end = end; }
+
+    /**
+     * Return parameter no. 'position' (0..4) or YCPNull if there is none.
+     **/
+    YCPValue parameter( int position ) const;
+
+    /**
+     * Return a copy of this call with the same function and parameters.
+     **/
+    YUIFunction * clone() const;
 };
 
 
@@ -107,8 +141,50 @@ class YUINamespace: public Y2Namespace
 private:
     void registerFunctions();
 
+    /**
+     * The range [begin, end) of m_symbols with all overloads of one builtin
+     * and the flags for calls of that builtin, all precomputed by
+     * buildSymbolIndex() so they don't have to be found for each call.
+     **/
+    struct SymbolRange
+    {
+	SymbolRange()
+	    : begin(0), end(0), playMacroBlocks( false )
+	    , asyncResult( YCPNull() ), asyncCoalesce( false )
+	    , batchRecord( false ), batchBarrier( false ), batchEnd( false )
+	    {}
+
+	size_t		begin;
+	size_t		end;
+	bool		playMacroBlocks;
+	YCPValue	asyncResult;
+	bool		asyncCoalesce;
+	bool		batchRecord;
+	bool		batchBarrier;
+	bool		batchEnd;
+    };
+
+    /**
+     * Build the index from builtin names to their SymbolRange.
+     **/
+    void buildSymbolIndex();
+
+    /**
+     * Return the SymbolRange of builtin 'name' or 0 if there is no such
+     * builtin. Rebuild the index first if m_symbols changed.
+     **/
+    const SymbolRange * findSymbols( const string & name );
+
+    /**
+     * Set the flags for async mode and batches of 'function' from 'range'.
+     **/
+    void setCallFlags( YUIFunction * function, const SymbolRange * range );
+
     vector<string> _registered_functions;
 
+    std::unordered_map<string, SymbolRange> _symbolIndex;
+    size_t _indexedSymbols;	// size of m_symbols when the index was built
+
     YUIComponent* m_comp;
 
 public:
@@ -205,6 +281,9 @@ public:
     /* TYPEINFO: boolean (term, term, any) */
     YCPValue ChangeWidget( const YCPTerm & widget_id, const YCPTerm & property, const YCPValue & new_value );
 
+    /* TYPEINFO: list<boolean> (list<list>) */
+    YCPValue ChangeWidgets( const YCPList & changes );
+
     /* TYPEINFO: any (symbol, symbol) */
     YCPValue QueryWidget( const YCPSymbol & widget_id, const YCPSymbol & property );
 
@@ -217,6 +296,9 @@ public:
     /* TYPEINFO: any (term, term) */
     YCPValue QueryWidget( const YCPTerm & widget_id, const YCPTerm & property );
 
+    /* TYPEINFO: map<list,any> (list<list>) */
+    YCPValue QueryWidgets( const YCPList & queries );
+
     /* TYPEINFO: boolean (symbol, term) */
     YCPValue ReplaceWidget( const YCPSymbol & widget_id, const YCPTerm & new_widget );
 
@@ -331,6 +413,21 @@ public:
     /* TYPEINFO: void(string) */
     YCPValue SetApplicationTitle( const YCPString & text);
 
+    /* TYPEINFO: void(boolean) */
+    YCPValue SetAsyncMode( const YCPBoolean & async );
+
+    /* TYPEINFO: void() */
+    YCPValue FlushAsyncCalls();
+
+    /* TYPEINFO: map<string,any> () */
+    YCPValue AsyncCallStats();
+
+    /* TYPEINFO: void() */
+    YCPValue BeginBatch();
+
+    /* TYPEINFO: list<any> () */
+    YCPValue EndBatch();
+
     YCPValue
     CallHandler( void * ptr, int argc, YCPValue argv[] );
 };